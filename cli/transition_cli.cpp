@@ -0,0 +1,393 @@
+/// __________________________________________________
+/// transition_cli.cpp
+/// __________________________________________________
+
+/// Command-line batch tool finding previous dates, previous results and transitions
+/// using the header-only core, without R.
+///
+/// CSV input (file or stdin) must have a header row. Time points may be ISO 8601 dates
+/// (YYYY-MM-DD) or integer days since 1970-01-01; subjects may be any text; results are
+/// integers, or labels given in order by --levels. Each input row is written with added
+/// prev_date, prev_result and transition columns, in the same representations.
+///
+/// Columnar input (--columns) is three files of native int32 values: subjects, time points
+/// as days since 1970-01-01, and results, with INT_MIN as missing. Outputs are written as
+/// files of int32 values named by appending .prev_date, .prev_result and .transition to
+/// the output prefix.
+
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "transition_core.h"
+
+using std::cerr;
+using std::string;
+using std::vector;
+
+const int na_int { TRANSITION_NA_INTEGER };
+
+/// __________________________________________________
+/// Options
+
+struct Options {
+	string subject { "subject" };
+	string timepoint { "timepoint" };
+	string result { "result" };
+	vector<string> levels;
+	int cap = 0;
+	int modulate = 0;
+	bool columnar = false;
+	bool timing = false;
+	vector<string> inputs;
+	string output;
+};
+
+static void usage(const char* prog)
+{
+	cerr << "Usage: " << prog << " [options] [input.csv]\n"
+		 << "       " << prog << " [options] --columns SUBJECT TIMEPOINT RESULT -o PREFIX\n\n"
+		 << "Options:\n"
+		 << "  --subject NAME     subject column name (default \"subject\")\n"
+		 << "  --timepoint NAME   time point column name (default \"timepoint\")\n"
+		 << "  --result NAME      result column name (default \"result\")\n"
+		 << "  --levels A,B,...   ordered result labels, lowest first\n"
+		 << "  --cap N            cap for transitions (default 0)\n"
+		 << "  --modulate N       modulator for transitions (default 0)\n"
+		 << "  --columns          read native int32 column files rather than CSV\n"
+		 << "  -o, --output PATH  output CSV file, or prefix for column files (default stdout)\n"
+		 << "  --time             report elapsed time of the computation on stderr\n";
+}
+
+static vector<string> split(const string& line, char sep)
+{
+	vector<string> fields;
+	string field;
+	bool quoted { false };
+	for (size_t i { 0 }; i < line.size(); ++i) {
+		char c { line[i] };
+		if (quoted) {
+			if (c == '"' && i + 1 < line.size() && line[i + 1] == '"')
+				field += line[++i];
+			else if (c == '"')
+				quoted = false;
+			else
+				field += c;
+		} else if (c == '"')
+			quoted = true;
+		else if (c == sep) {
+			fields.push_back(field);
+			field.clear();
+		} else if (c != '\r')
+			field += c;
+	}
+	fields.push_back(field);
+	return fields;
+}
+
+static Options parse_args(int argc, char* argv[])
+{
+	Options opt;
+	for (int i { 1 }; i < argc; ++i) {
+		string arg { argv[i] };
+		auto value = [&]() -> string {
+			if (i + 1 >= argc)
+				throw std::invalid_argument("option " + arg + " requires a value");
+			return argv[++i];
+		};
+		if (arg == "--subject")
+			opt.subject = value();
+		else if (arg == "--timepoint")
+			opt.timepoint = value();
+		else if (arg == "--result")
+			opt.result = value();
+		else if (arg == "--levels")
+			opt.levels = split(value(), ',');
+		else if (arg == "--cap")
+			opt.cap = std::stoi(value());
+		else if (arg == "--modulate")
+			opt.modulate = std::stoi(value());
+		else if (arg == "--columns")
+			opt.columnar = true;
+		else if (arg == "-o" || arg == "--output")
+			opt.output = value();
+		else if (arg == "--time")
+			opt.timing = true;
+		else if (arg == "-h" || arg == "--help") {
+			usage(argv[0]);
+			exit(EXIT_SUCCESS);
+		} else if (arg.size() > 1 && arg[0] == '-')
+			throw std::invalid_argument("unknown option " + arg);
+		else
+			opt.inputs.push_back(arg);
+	}
+	return opt;
+}
+
+
+/// __________________________________________________
+/// Dates, as days since 1970-01-01 (see H. Hinnant, chrono-Compatible Low-Level Date Algorithms)
+
+static int days_from_civil(int y, unsigned m, unsigned d)
+{
+	y -= m <= 2;
+	const int era { (y >= 0 ? y : y - 399) / 400 };
+	const unsigned yoe = y - era * 400;
+	const unsigned doy { (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1 };
+	const unsigned doe { yoe * 365 + yoe / 4 - yoe / 100 + doy };
+	return era * 146097 + int(doe) - 719468;
+}
+
+static string civil_from_days(int z)
+{
+	z += 719468;
+	const int era { (z >= 0 ? z : z - 146096) / 146097 };
+	const unsigned doe = z - era * 146097;
+	const unsigned yoe { (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365 };
+	const unsigned doy { doe - (365 * yoe + yoe / 4 - yoe / 100) };
+	const unsigned mp { (5 * doy + 2) / 153 };
+	const unsigned d { doy - (153 * mp + 2) / 5 + 1 };
+	const unsigned m { mp < 10 ? mp + 3 : mp - 9 };
+	char buf[32];
+	snprintf(buf, sizeof buf, "%04d-%02u-%02u", int(yoe) + era * 400 + (m <= 2), m, d);
+	return buf;
+}
+
+static bool is_missing(const string& field)
+{
+	return field.empty() || field == "NA";
+}
+
+static bool is_iso_date(const string& field)
+{
+	return field.size() == 10 && field[4] == '-' && field[7] == '-';
+}
+
+// Days since 1970-01-01 of an ISO 8601 date, throwing unless it is a valid calendar date
+static int parse_iso_date(const string& field, size_t row)
+{
+	static const unsigned mdays[] { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	for (size_t i { 0 }; i < field.size(); ++i)
+		if (i != 4 && i != 7 && !std::isdigit(static_cast<unsigned char>(field[i])))
+			throw std::invalid_argument("row " + std::to_string(row) + ": time point \"" + field + "\" not a valid date");
+	int y { std::stoi(field.substr(0, 4)) };
+	unsigned m = std::stoi(field.substr(5, 2)), d = std::stoi(field.substr(8, 2));
+	bool leap { (y % 4 == 0 && y % 100 != 0) || y % 400 == 0 };
+	if (m < 1 || m > 12 || d < 1 || d > mdays[m - 1] + (m == 2 && leap))
+		throw std::invalid_argument("row " + std::to_string(row) + ": time point \"" + field + "\" not a valid date");
+	return days_from_civil(y, m, d);
+}
+
+// Value of a whole numeric field, throwing if any of it is left unread
+template<class T>
+static T parse_field(const string& field, const char* what, size_t row)
+{
+	size_t pos { 0 };
+	T value {};
+	try {
+		value = std::is_integral<T>::value ? T(std::stoi(field, &pos)) : T(std::stod(field, &pos));
+	} catch (std::logic_error&) {
+		pos = 0;
+	}
+	if (!pos || pos != field.size())
+		throw std::invalid_argument("row " + std::to_string(row) + ": " + what + " \"" + field + "\" not " + (std::is_integral<T>::value ? "an integer" : "a number"));
+	return value;
+}
+
+
+/// __________________________________________________
+/// Columnar input and output
+
+static vector<int32_t> read_column(const string& path)
+{
+	std::ifstream in(path, std::ios::binary | std::ios::ate);
+	if (!in)
+		throw std::runtime_error("cannot open " + path);
+	vector<int32_t> col(in.tellg() / sizeof(int32_t));
+	in.seekg(0);
+	in.read(reinterpret_cast<char*>(col.data()), col.size() * sizeof(int32_t));
+	return col;
+}
+
+static void write_column(const string& path, const vector<int>& col)
+{
+	std::ofstream out(path, std::ios::binary);
+	if (!out)
+		throw std::runtime_error("cannot open " + path);
+	vector<int32_t> buf(col.begin(), col.end());
+	out.write(reinterpret_cast<const char*>(buf.data()), buf.size() * sizeof(int32_t));
+}
+
+// View of int32 days as time points, with INT_MIN as missing
+struct Dayview {
+	const vector<int32_t>& days;
+	double operator[](size_t row) const { return na_int == days[row] ? TRANSITION_NA_REAL : days[row]; }
+};
+
+static int run_columnar(const Options& opt)
+{
+	if (opt.inputs.size() != 3 || opt.output.empty())
+		throw std::invalid_argument("--columns requires three input files and an output prefix");
+	auto id { read_column(opt.inputs[0]) };
+	auto rawdates { read_column(opt.inputs[1]) };
+	auto result { read_column(opt.inputs[2]) };
+	if (id.size() != rawdates.size() || id.size() != result.size())
+		throw std::invalid_argument("input columns of different lengths");
+	Dayview date { rawdates };
+
+	auto start { std::chrono::steady_clock::now() };
+	int nrows = id.size();
+	auto prevrow { prev_rows(id, date, nrows) };
+	vector<int> prevdate(nrows), prevres(nrows);
+	for (int row { 0 }; row < nrows; ++row) {
+		prevdate[row] = prevrow[row] < 0 ? na_int : rawdates[prevrow[row]];
+		prevres[row] = prevrow[row] < 0 ? na_int : result[prevrow[row]];
+	}
+	auto transitions { transition_rows(prevrow, result, opt.cap, opt.modulate) };
+	if (opt.timing)
+		cerr << nrows << " rows in " << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s\n";
+
+	write_column(opt.output + ".prev_date", prevdate);
+	write_column(opt.output + ".prev_result", prevres);
+	write_column(opt.output + ".transition", transitions);
+	return EXIT_SUCCESS;
+}
+
+
+/// __________________________________________________
+/// CSV input and output
+
+static size_t find_column(const vector<string>& header, const string& name)
+{
+	auto it { std::find(header.begin(), header.end(), name) };
+	if (it == header.end())
+		throw std::invalid_argument("no column named \"" + name + "\"");
+	return it - header.begin();
+}
+
+static int run_csv(const Options& opt)
+{
+	if (opt.inputs.size() > 1)
+		throw std::invalid_argument("more than one CSV input file");
+	std::ifstream file;
+	if (!opt.inputs.empty()) {
+		file.open(opt.inputs[0]);
+		if (!file)
+			throw std::runtime_error("cannot open " + opt.inputs[0]);
+	}
+	std::istream& in { opt.inputs.empty() ? std::cin : file };
+
+	string line;
+	if (!std::getline(in, line))
+		throw std::invalid_argument("empty input");
+	if (!line.empty() && line.back() == '\r')
+		line.pop_back();
+	if (line.empty())
+		throw std::invalid_argument("empty header");
+	string headerline { line };
+	auto header { split(headerline, ',') };
+	size_t idcol { find_column(header, opt.subject) }, datecol { find_column(header, opt.timepoint) }, testcol { find_column(header, opt.result) };
+
+	std::map<string, int> subjects, levels;
+	for (size_t l { 0 }; l < opt.levels.size(); ++l)
+		levels[opt.levels[l]] = l + 1;
+	vector<string> lines;
+	vector<int> id, result;
+	vector<double> date;
+	bool isodate { false };
+	while (std::getline(in, line)) {
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty())
+			continue;
+		auto fields { split(line, ',') };
+		if (fields.size() != header.size())
+			throw std::invalid_argument("row " + std::to_string(lines.size() + 1) + " has " + std::to_string(fields.size()) + " fields");
+		const string& sub { fields[idcol] };
+		const string& dat { fields[datecol] };
+		const string& res { fields[testcol] };
+		id.push_back(subjects.emplace(sub, subjects.size()).first->second);
+		if (is_missing(dat))
+			date.push_back(TRANSITION_NA_REAL);
+		else if (is_iso_date(dat)) {
+			isodate = true;
+			date.push_back(parse_iso_date(dat, lines.size() + 1));
+		} else
+			date.push_back(parse_field<double>(dat, "time point", lines.size() + 1));
+		if (is_missing(res))
+			result.push_back(na_int);
+		else if (!levels.empty()) {
+			auto it { levels.find(res) };
+			if (it == levels.end())
+				throw std::invalid_argument("result \"" + res + "\" not in --levels");
+			result.push_back(it->second);
+		} else
+			result.push_back(parse_field<int>(res, "result", lines.size() + 1));
+		lines.push_back(line);
+	}
+
+	auto start { std::chrono::steady_clock::now() };
+	int nrows = lines.size();
+	auto prevrow { prev_rows(id, date, nrows) };
+	auto transitions { transition_rows(prevrow, result, opt.cap, opt.modulate) };
+	if (opt.timing)
+		cerr << nrows << " rows in " << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s\n";
+
+	std::ofstream outfile;
+	if (!opt.output.empty()) {
+		outfile.open(opt.output);
+		if (!outfile)
+			throw std::runtime_error("cannot open " + opt.output);
+	}
+	std::ostream& out { opt.output.empty() ? std::cout : outfile };
+	out << headerline << ",prev_date,prev_result,transition\n";
+	for (int row { 0 }; row < nrows; ++row) {
+		int prev { prevrow[row] };
+		out << lines[row] << ',';
+		if (prev < 0)
+			out << "NA,NA,";
+		else {
+			if (isodate)
+				out << civil_from_days(date[prev]);
+			else if (date[prev] == std::floor(date[prev]) && std::abs(date[prev]) < 1e15)
+				out << static_cast<long long>(date[prev]);
+			else
+				out << std::setprecision(17) << date[prev];
+			out << ',';
+			if (na_int == result[prev])
+				out << "NA";
+			else if (!opt.levels.empty())
+				out << opt.levels[result[prev] - 1];
+			else
+				out << result[prev];
+			out << ',';
+		}
+		if (na_int == transitions[row])
+			out << "NA\n";
+		else
+			out << transitions[row] << '\n';
+	}
+	return EXIT_SUCCESS;
+}
+
+
+int main(int argc, char* argv[])
+{
+	try {
+		Options opt { parse_args(argc, argv) };
+		return opt.columnar ? run_columnar(opt) : run_csv(opt);
+	} catch (std::exception& e) {
+		cerr << "Error: " << e.what() << '\n';
+		usage(argv[0]);
+	}
+	return EXIT_FAILURE;
+}
@@ -11,8 +11,8 @@ Rcpp::Rostream<false>& Rcpp::Rcerr = Rcpp::Rcpp_cerr_get();
 #endif
 
 // add_transitions
-DataFrame add_transitions(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* transition, int cap, int modulate);
-RcppExport SEXP _Transition_add_transitions(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP transitionSEXP, SEXP capSEXP, SEXP modulateSEXP) {
+DataFrame add_transitions(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* transition, int cap, int modulate, bool progress, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_add_transitions(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP transitionSEXP, SEXP capSEXP, SEXP modulateSEXP, SEXP progressSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -23,13 +23,16 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const char* >::type transition(transitionSEXP);
     Rcpp::traits::input_parameter< int >::type cap(capSEXP);
     Rcpp::traits::input_parameter< int >::type modulate(modulateSEXP);
-    rcpp_result_gen = Rcpp::wrap(add_transitions(object, subject, timepoint, result, transition, cap, modulate));
+    Rcpp::traits::input_parameter< bool >::type progress(progressSEXP);
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(add_transitions(object, subject, timepoint, result, transition, cap, modulate, progress, sequence, duplicates));
     return rcpp_result_gen;
 END_RCPP
 }
 // get_transitions
-IntegerVector get_transitions(DataFrame object, const char* subject, const char* timepoint, const char* result, int cap, int modulate);
-RcppExport SEXP _Transition_get_transitions(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP capSEXP, SEXP modulateSEXP) {
+IntegerVector get_transitions(DataFrame object, const char* subject, const char* timepoint, const char* result, int cap, int modulate, bool progress, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_get_transitions(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP capSEXP, SEXP modulateSEXP, SEXP progressSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -39,13 +42,16 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
     Rcpp::traits::input_parameter< int >::type cap(capSEXP);
     Rcpp::traits::input_parameter< int >::type modulate(modulateSEXP);
-    rcpp_result_gen = Rcpp::wrap(get_transitions(object, subject, timepoint, result, cap, modulate));
+    Rcpp::traits::input_parameter< bool >::type progress(progressSEXP);
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(get_transitions(object, subject, timepoint, result, cap, modulate, progress, sequence, duplicates));
     return rcpp_result_gen;
 END_RCPP
 }
 // add_prev_date
-DataFrame add_prev_date(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* prev_date);
-RcppExport SEXP _Transition_add_prev_date(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP prev_dateSEXP) {
+DataFrame add_prev_date(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* prev_date, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_add_prev_date(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP prev_dateSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -54,13 +60,15 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const char* >::type timepoint(timepointSEXP);
     Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
     Rcpp::traits::input_parameter< const char* >::type prev_date(prev_dateSEXP);
-    rcpp_result_gen = Rcpp::wrap(add_prev_date(object, subject, timepoint, result, prev_date));
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(add_prev_date(object, subject, timepoint, result, prev_date, sequence, duplicates));
     return rcpp_result_gen;
 END_RCPP
 }
 // get_prev_date
-DateVector get_prev_date(DataFrame object, const char* subject, const char* timepoint, const char* result);
-RcppExport SEXP _Transition_get_prev_date(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP) {
+DateVector get_prev_date(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_get_prev_date(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -68,13 +76,15 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const char* >::type subject(subjectSEXP);
     Rcpp::traits::input_parameter< const char* >::type timepoint(timepointSEXP);
     Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
-    rcpp_result_gen = Rcpp::wrap(get_prev_date(object, subject, timepoint, result));
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(get_prev_date(object, subject, timepoint, result, sequence, duplicates));
     return rcpp_result_gen;
 END_RCPP
 }
 // add_prev_result
-DataFrame add_prev_result(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* prev_result);
-RcppExport SEXP _Transition_add_prev_result(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP prev_resultSEXP) {
+DataFrame add_prev_result(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* prev_result, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_add_prev_result(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP prev_resultSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -83,13 +93,15 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const char* >::type timepoint(timepointSEXP);
     Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
     Rcpp::traits::input_parameter< const char* >::type prev_result(prev_resultSEXP);
-    rcpp_result_gen = Rcpp::wrap(add_prev_result(object, subject, timepoint, result, prev_result));
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(add_prev_result(object, subject, timepoint, result, prev_result, sequence, duplicates));
     return rcpp_result_gen;
 END_RCPP
 }
 // get_prev_result
-IntegerVector get_prev_result(DataFrame object, const char* subject, const char* timepoint, const char* result);
-RcppExport SEXP _Transition_get_prev_result(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP) {
+IntegerVector get_prev_result(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_get_prev_result(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -97,7 +109,9 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const char* >::type subject(subjectSEXP);
     Rcpp::traits::input_parameter< const char* >::type timepoint(timepointSEXP);
     Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
-    rcpp_result_gen = Rcpp::wrap(get_prev_result(object, subject, timepoint, result));
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(get_prev_result(object, subject, timepoint, result, sequence, duplicates));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -115,15 +129,190 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// add_rolling
+DataFrame add_rolling(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* rolling, int window, const char* unit, int positive, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_add_rolling(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP rollingSEXP, SEXP windowSEXP, SEXP unitSEXP, SEXP positiveSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< DataFrame >::type object(objectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type subject(subjectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type timepoint(timepointSEXP);
+    Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
+    Rcpp::traits::input_parameter< const char* >::type rolling(rollingSEXP);
+    Rcpp::traits::input_parameter< int >::type window(windowSEXP);
+    Rcpp::traits::input_parameter< const char* >::type unit(unitSEXP);
+    Rcpp::traits::input_parameter< int >::type positive(positiveSEXP);
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(add_rolling(object, subject, timepoint, result, rolling, window, unit, positive, sequence, duplicates));
+    return rcpp_result_gen;
+END_RCPP
+}
+// get_rolling
+DataFrame get_rolling(DataFrame object, const char* subject, const char* timepoint, const char* result, int window, const char* unit, int positive, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_get_rolling(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP windowSEXP, SEXP unitSEXP, SEXP positiveSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< DataFrame >::type object(objectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type subject(subjectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type timepoint(timepointSEXP);
+    Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
+    Rcpp::traits::input_parameter< int >::type window(windowSEXP);
+    Rcpp::traits::input_parameter< const char* >::type unit(unitSEXP);
+    Rcpp::traits::input_parameter< int >::type positive(positiveSEXP);
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(get_rolling(object, subject, timepoint, result, window, unit, positive, sequence, duplicates));
+    return rcpp_result_gen;
+END_RCPP
+}
+// get_markov
+List get_markov(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* stratum, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_get_markov(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP stratumSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< DataFrame >::type object(objectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type subject(subjectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type timepoint(timepointSEXP);
+    Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
+    Rcpp::traits::input_parameter< const char* >::type stratum(stratumSEXP);
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(get_markov(object, subject, timepoint, result, stratum, sequence, duplicates));
+    return rcpp_result_gen;
+END_RCPP
+}
+// get_bootstrap
+RObject get_bootstrap(DataFrame object, const char* subject, const char* timepoint, const char* result, int cap, int modulate, int nboot, double conf, bool intervals, int seed, int threads, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_get_bootstrap(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP capSEXP, SEXP modulateSEXP, SEXP nbootSEXP, SEXP confSEXP, SEXP intervalsSEXP, SEXP seedSEXP, SEXP threadsSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< DataFrame >::type object(objectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type subject(subjectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type timepoint(timepointSEXP);
+    Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
+    Rcpp::traits::input_parameter< int >::type cap(capSEXP);
+    Rcpp::traits::input_parameter< int >::type modulate(modulateSEXP);
+    Rcpp::traits::input_parameter< int >::type nboot(nbootSEXP);
+    Rcpp::traits::input_parameter< double >::type conf(confSEXP);
+    Rcpp::traits::input_parameter< bool >::type intervals(intervalsSEXP);
+    Rcpp::traits::input_parameter< int >::type seed(seedSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(get_bootstrap(object, subject, timepoint, result, cap, modulate, nboot, conf, intervals, seed, threads, sequence, duplicates));
+    return rcpp_result_gen;
+END_RCPP
+}
+// arrow_transitions
+void arrow_transitions(List subject, List timepoint, List result, Nullable<List> prev_date, Nullable<List> prev_result, Nullable<List> transition, int cap, int modulate);
+RcppExport SEXP _Transition_arrow_transitions(SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP prev_dateSEXP, SEXP prev_resultSEXP, SEXP transitionSEXP, SEXP capSEXP, SEXP modulateSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< List >::type subject(subjectSEXP);
+    Rcpp::traits::input_parameter< List >::type timepoint(timepointSEXP);
+    Rcpp::traits::input_parameter< List >::type result(resultSEXP);
+    Rcpp::traits::input_parameter< Nullable<List> >::type prev_date(prev_dateSEXP);
+    Rcpp::traits::input_parameter< Nullable<List> >::type prev_result(prev_resultSEXP);
+    Rcpp::traits::input_parameter< Nullable<List> >::type transition(transitionSEXP);
+    Rcpp::traits::input_parameter< int >::type cap(capSEXP);
+    Rcpp::traits::input_parameter< int >::type modulate(modulateSEXP);
+    arrow_transitions(subject, timepoint, result, prev_date, prev_result, transition, cap, modulate);
+    return R_NilValue;
+END_RCPP
+}
+// get_ngrams
+DataFrame get_ngrams(DataFrame object, const char* subject, const char* timepoint, const char* result, int k, int min_support, int threads, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_get_ngrams(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP kSEXP, SEXP min_supportSEXP, SEXP threadsSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< DataFrame >::type object(objectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type subject(subjectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type timepoint(timepointSEXP);
+    Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    Rcpp::traits::input_parameter< int >::type min_support(min_supportSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(get_ngrams(object, subject, timepoint, result, k, min_support, threads, sequence, duplicates));
+    return rcpp_result_gen;
+END_RCPP
+}
+// get_first_transition
+DataFrame get_first_transition(DataFrame object, const char* subject, const char* timepoint, const char* result, int cap, int modulate, const char* direction, int magnitude, const char* sequence, const char* duplicates);
+RcppExport SEXP _Transition_get_first_transition(SEXP objectSEXP, SEXP subjectSEXP, SEXP timepointSEXP, SEXP resultSEXP, SEXP capSEXP, SEXP modulateSEXP, SEXP directionSEXP, SEXP magnitudeSEXP, SEXP sequenceSEXP, SEXP duplicatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< DataFrame >::type object(objectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type subject(subjectSEXP);
+    Rcpp::traits::input_parameter< const char* >::type timepoint(timepointSEXP);
+    Rcpp::traits::input_parameter< const char* >::type result(resultSEXP);
+    Rcpp::traits::input_parameter< int >::type cap(capSEXP);
+    Rcpp::traits::input_parameter< int >::type modulate(modulateSEXP);
+    Rcpp::traits::input_parameter< const char* >::type direction(directionSEXP);
+    Rcpp::traits::input_parameter< int >::type magnitude(magnitudeSEXP);
+    Rcpp::traits::input_parameter< const char* >::type sequence(sequenceSEXP);
+    Rcpp::traits::input_parameter< const char* >::type duplicates(duplicatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(get_first_transition(object, subject, timepoint, result, cap, modulate, direction, magnitude, sequence, duplicates));
+    return rcpp_result_gen;
+END_RCPP
+}
+// transition_cache
+void transition_cache(bool enable, double max_size);
+RcppExport SEXP _Transition_transition_cache(SEXP enableSEXP, SEXP max_sizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< bool >::type enable(enableSEXP);
+    Rcpp::traits::input_parameter< double >::type max_size(max_sizeSEXP);
+    transition_cache(enable, max_size);
+    return R_NilValue;
+END_RCPP
+}
+// transition_cache_info
+List transition_cache_info();
+RcppExport SEXP _Transition_transition_cache_info() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(transition_cache_info());
+    return rcpp_result_gen;
+END_RCPP
+}
+// transition_cache_clear
+void transition_cache_clear();
+RcppExport SEXP _Transition_transition_cache_clear() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    transition_cache_clear();
+    return R_NilValue;
+END_RCPP
+}
 
 static const R_CallMethodDef CallEntries[] = {
-    {"_Transition_add_transitions", (DL_FUNC) &_Transition_add_transitions, 7},
-    {"_Transition_get_transitions", (DL_FUNC) &_Transition_get_transitions, 6},
-    {"_Transition_add_prev_date", (DL_FUNC) &_Transition_add_prev_date, 5},
-    {"_Transition_get_prev_date", (DL_FUNC) &_Transition_get_prev_date, 4},
-    {"_Transition_add_prev_result", (DL_FUNC) &_Transition_add_prev_result, 5},
-    {"_Transition_get_prev_result", (DL_FUNC) &_Transition_get_prev_result, 4},
+    {"_Transition_add_transitions", (DL_FUNC) &_Transition_add_transitions, 10},
+    {"_Transition_get_transitions", (DL_FUNC) &_Transition_get_transitions, 9},
+    {"_Transition_add_prev_date", (DL_FUNC) &_Transition_add_prev_date, 7},
+    {"_Transition_get_prev_date", (DL_FUNC) &_Transition_get_prev_date, 6},
+    {"_Transition_add_prev_result", (DL_FUNC) &_Transition_add_prev_result, 7},
+    {"_Transition_get_prev_result", (DL_FUNC) &_Transition_get_prev_result, 6},
     {"_Transition_uniques", (DL_FUNC) &_Transition_uniques, 4},
+    {"_Transition_add_rolling", (DL_FUNC) &_Transition_add_rolling, 10},
+    {"_Transition_get_rolling", (DL_FUNC) &_Transition_get_rolling, 9},
+    {"_Transition_get_markov", (DL_FUNC) &_Transition_get_markov, 7},
+    {"_Transition_get_bootstrap", (DL_FUNC) &_Transition_get_bootstrap, 13},
+    {"_Transition_arrow_transitions", (DL_FUNC) &_Transition_arrow_transitions, 8},
+    {"_Transition_get_ngrams", (DL_FUNC) &_Transition_get_ngrams, 9},
+    {"_Transition_get_first_transition", (DL_FUNC) &_Transition_get_first_transition, 10},
+    {"_Transition_transition_cache", (DL_FUNC) &_Transition_transition_cache, 2},
+    {"_Transition_transition_cache_info", (DL_FUNC) &_Transition_transition_cache_info, 0},
+    {"_Transition_transition_cache_clear", (DL_FUNC) &_Transition_transition_cache_clear, 0},
     {NULL, NULL, 0}
 };
 
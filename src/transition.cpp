@@ -5,6 +5,10 @@
 #include <cxxabi.h>
 using namespace Rcpp;
 
+#define TRANSITION_NA_INTEGER NA_INTEGER
+#define TRANSITION_NA_REAL NA_REAL
+#include "transition_core.h"
+#include "arrow_c.h"
 #include "transition.h"
 
 using std::cout;
@@ -79,30 +83,9 @@ int colpos(const DataFrame object, const char* colname)
 }
 
 
-// Find unique values in vector
-template<class T>
-vector<T> get_unique(const vector<T> vec)
-{
-//	cout << "@get_unique<T>(const vector<T>) vec " << Demangler(typeid(vec)) << endl;
-	vector<T> out { vec };
-	std::sort(out.begin(), out.end());
-	auto last { std::unique(out.begin(), out.end()) };
-	out.erase(last, out.end());
-	return out;
-}
-
-// Adjust the difference,symmetrically
-inline int adjust(int diff, int cap, int modulate)
-{
-//	cout << "@adjust(int) diff " << diff << endl;
-	bool neg = std::signbit(diff);
-	diff = abs(diff);
-	if (modulate > 1)
-		diff = (diff + modulate - 1) / modulate;
-	if (bool(cap))
-		diff = (diff < cap) ? diff : cap;
-	return neg ? diff *= -1 : diff;
-}
+/// __________________________________________________
+/// Cache of groupings by subject and time point columns, disabled by default
+static Groupcache groupcache { size_t(256) << 20 };
 
 
 /// __________________________________________________
@@ -172,47 +155,103 @@ T Transitiondata::typechecker(int colno, int arg)
 }
 
 
-// Test result for given subject and date
-int Transitiondata::get_result(int subject, double date) const
+// Grouping of rows by subject and date, with results and previous rows, from the cache if enabled,
+// keyed on the columns as given rather than as converted and holding them while cached
+const Grouped& Transitiondata::grouping() const
 {
-//	cout << "@Transitiondata::get_result(int, double) const subject = " << subject << "; date = " << Date(date).getYear() << endl;
-	for (int x { 0 }; x < nrows; ++x)
-		if (id[x] == subject && testdate[x] == date) {
-			return testresult[x];
+//	cout << "@Transitiondata::grouping() const\n";
+	if (grouped)
+		return *grouped;
+	auto build = [this]() {
+		if (!seqsrc.isNULL())
+			return std::make_shared<const Grouped>(id, testdate, nrows, progress, sequence, testresult, dups);
+		return std::make_shared<const Grouped>(id, testdate, nrows, progress, Nocolumn(), testresult, dups);
+	};
+	if (groupcache.enabled()) {
+		Fingerprint fp { fingerprint(SEXP(idsrc), id, SEXP(datesrc), testdate, nrows) };
+		fp.dups = dups;
+		fp.result = SEXP(testsrc);
+		fp.sample(testresult);
+		auto keep { std::make_shared<vector<RObject>>(vector<RObject> { idsrc, datesrc, testsrc }) };
+		if (!seqsrc.isNULL()) {
+			fp.seq = SEXP(seqsrc);
+			fp.sample(sequence);
+			keep->push_back(seqsrc);
 		}
-	return NA_INTEGER;
+		grouped = groupcache.get(fp, build, keep);
+	} else
+		grouped = build();
+	return *grouped;
 }
 
-// All dates for a given subject, sorted
-std::vector<double> Transitiondata::get_id_dates(int target) const
+
+// Row of the most recent previous test for each row, or -1 if none
+const vector<int>& Transitiondata::prev_row() const
 {
-//	cout << "@Transitiondata::get_id_dates(int id) const target = " << target << endl;
-	vector<double> out;
-	for (int x { 0 }; x < nrows; ++x) {
-		if (id[x] == target)
-			out.push_back(testdate[x]);
-	}
-	std::sort(out.begin(), out.end());
-	return out;
+//	cout << "@Transitiondata::prev_row() const\n";
+	return grouping().prevrow;
+}
+
+
+// Report progress between chunks, as well as checking for user interrupts
+Transitiondata& Transitiondata::report_progress(bool report)
+{
+//	cout << "@Transitiondata::report_progress(bool) report " << report << endl;
+	if (report)
+		progress = [](const char* step, long done, long total) {
+			checkUserInterrupt();
+			progress_report(step, done, total);
+		};
+	return *this;
+}
+
+
+// Order tests of a subject at the same time point by a sequence column, and treat duplicates
+Transitiondata& Transitiondata::order_by(const char* seqname, const char* duplicates)
+{
+//	cout << "@Transitiondata::order_by(const char*, const char*) seqname " << seqname << "; duplicates " << duplicates << endl;
+	string dupstr { str_tolower(duplicates) };
+	if ("error" == dupstr)
+		dups = Duplicates::error;
+	else if ("first" == dupstr)
+		dups = Duplicates::first;
+	else if ("last" == dupstr)
+		dups = Duplicates::last;
+	else if ("aggregate" == dupstr)
+		dups = Duplicates::aggregate;
+	else
+		throw std::invalid_argument("\"duplicates\" must be \"error\", \"first\", \"last\" or \"aggregate\"");
+	if (!*seqname)
+		return *this;
+	RObject seqobj { df[colpos(df, seqname)] };
+	if (TYPEOF(seqobj) != INTSXP && TYPEOF(seqobj) != REALSXP)
+		throw std::invalid_argument(string("column `") + seqname + "` neither integer nor numeric");
+	seqsrc = seqobj;
+	sequence = as<NumericVector>(seqobj);
+	return *this;
 }
 
-// most recent previous date for subject
-double Transitiondata::get_prevdate(int subject, double date) const
+
+// Unique subjects, from the grouping if cached
+vector<int> Transitiondata::unique_sub() const
 {
-//	cout << "@Transitiondata::get_prevdate(int, double) const subject = " << subject << "; date = " << Date(date).getYear() << endl;
-	auto dates { get_id_dates(subject) };
-	auto it { find(dates.begin(), dates.end(), date) };
-	if (it == dates.end())
-		stop("testdate %s not found for subject %i.", Date(date).format("%Y"), subject);
-	return (it == dates.begin()) ? NA_REAL : *std::prev(it);
+//	cout << "@Transitiondata::unique_sub() const\n";
+	if (!groupcache.enabled())
+		return get_unique(as<vector<int>>(id));
+	const Grouping& grp { grouping().grp };
+	vector<int> subjects(grp.nsub());
+	for (int s { 0 }; s < grp.nsub(); ++s)
+		subjects[s] = id[grp.index[grp.bounds[s]]];
+	return subjects;
 }
 
 // vector of the most recent previous date by subject
 vector<double> Transitiondata::prev_date() const
 {
 //	cout << "@Transitiondata::prev_date() const\n";
+	const auto& prevrow { prev_row() };
 	vector<double> previous(nrows);
-	transform(id.begin(), id.end(), testdate.begin(), previous.begin(), [this](int id, double date){ return get_prevdate(id, date); });
+	transform(prevrow.begin(), prevrow.end(), previous.begin(), [this](int row){ return row < 0 ? NA_REAL : testdate[row]; });
 	return previous;
 }
 
@@ -220,9 +259,9 @@ vector<double> Transitiondata::prev_date() const
 vector<int> Transitiondata::prev_result() const
 {
 //	cout << "@Transitiondata::prev_result() const\n";	
-	auto prevdate { prev_date() };
+	const auto& prevrow { prev_row() };
 	vector<int> prevres(nrows);
-	transform(id.begin(), id.end(), prevdate.begin(), prevres.begin(), [this](int id, double date){ return get_result(id, date); });
+	transform(prevrow.begin(), prevrow.end(), prevres.begin(), [this](int row){ return row < 0 ? NA_INTEGER : testresult[row]; });
 	return prevres;
 }
 
@@ -242,32 +281,243 @@ DataFrame Transitiondata::add_transition(const char* colname, int cap, int modul
 vector<int> Transitiondata::get_transition(int cap, int modulate) const
 {
 //	cout << "@Transitiondata::get_transition(int) cap = " << cap << "; modulate = " << modulate << endl;
-	if (cap < 0)
-		throw std::invalid_argument("\"cap\" less than zero");
-	if (modulate < 0)
-		throw std::invalid_argument("\"modulate\" less than zero");
-	auto previous { prev_result() };
-	std::vector<int> transitions(nrows);
-	transform(previous.begin(), previous.end(), testresult.begin(), transitions.begin(),
-		[cap, modulate](int prev, int curr) { return (NA_INTEGER == prev) ? NA_INTEGER : adjust(curr - prev, cap, modulate); }
-	);
-	return transitions;
+	return transition_rows(prev_row(), testresult, cap, modulate, progress);
+}
+
+
+// Rolling window statistics of past results within subjects, by number of tests or days
+Rollstats Transitiondata::rolling(int window, bool bydays, int positive) const
+{
+//	cout << "@Transitiondata::rolling(int, bool, int) const window = " << window << "; bydays = " << bydays << endl;
+	const Grouped& grouped { grouping() };
+	if (seqsrc.isNULL())
+		return rolling_stats(grouped.grp, testdate, grouped.res, window, bydays, positive, Nocolumn(), dups);
+	return rolling_stats(grouped.grp, testdate, grouped.res, window, bydays, positive, sequence, dups);
+}
+
+
+// Transition counts and time at risk between result levels, by stratum, in one pass
+vector<Markovstats> Transitiondata::markov(int nstates, int base, const vector<int>& stratum, int nstrata) const
+{
+//	cout << "@Transitiondata::markov(int, int, const vector<int>&, int) const nstates = " << nstates << "; nstrata = " << nstrata << endl;
+	return markov_stats(prev_row(), testdate, testresult, nstates, base, stratum, nstrata);
+}
+
+
+// Counts of each transition value for each subject
+Bootsummary Transitiondata::subject_transitions(int cap, int modulate) const
+{
+//	cout << "@Transitiondata::subject_transitions(int, int) const cap = " << cap << "; modulate = " << modulate << endl;
+	return subject_counts(id, get_transition(cap, modulate));
+}
+
+
+// Counts of sequences of k consecutive results within subjects
+vector<std::pair<uint64_t, int>> Transitiondata::ngrams(int k, int nlevels, int base, int minsupport, int threads) const
+{
+//	cout << "@Transitiondata::ngrams(int, int, int, int, int) const k = " << k << "; nlevels = " << nlevels << endl;
+	const Grouped& grouped { grouping() };
+	if (seqsrc.isNULL())
+		return ngram_counts(grouped.grp, testdate, grouped.res, k, nlevels, base, minsupport, threads, Nocolumn(), dups);
+	return ngram_counts(grouped.grp, testdate, grouped.res, k, nlevels, base, minsupport, threads, sequence, dups);
+}
+
+
+// Time to first transition in a given direction of at least a given magnitude for each subject
+Firststats Transitiondata::first_transition(int cap, int modulate, int direction, int magnitude) const
+{
+//	cout << "@Transitiondata::first_transition(int, int, int, int) const direction = " << direction << "; magnitude = " << magnitude << endl;
+	return first_transitions(grouping().grp, prev_row(), id, testdate, testresult, cap, modulate, direction, magnitude);
+}
+
+
+/// __________________________________________________
+/// Class Arrowcolumn
+
+// View of an integer, dictionary-encoded or date32 Arrow array, without copying
+template<typename U>
+Arrowcolumn<U>::Arrowcolumn(const ArrowArray* array, const ArrowSchema* schema, bool isdate, const char* colname)
+{
+//	cout << "@Arrowcolumn<U>::Arrowcolumn(const ArrowArray*, const ArrowSchema*, bool, const char*) colname " << colname << endl;
+	string errstr { string("Arrow array `") + colname + "`" };
+	if (!array->release || !schema->release)
+		throw std::invalid_argument(errstr + " has been released");
+	string format { schema->format };
+	if (isdate ? format != "tdD" : (format != "c" && format != "s" && format != "i"))
+		throw std::invalid_argument(errstr + (isdate ? " not of type date32" : " neither of type int8, int16 or int32 nor dictionary-encoded"));
+	if (array->n_buffers != 2)
+		throw std::invalid_argument(errstr + " does not have two buffers");
+	width = ("c" == format) ? 1 : ("s" == format) ? 2 : 4;
+	add = schema->dictionary ? 1 : 0;
+	valid = array->null_count ? static_cast<const uint8_t*>(array->buffers[0]) : nullptr;
+	data = array->buffers[1];
+	offset = array->offset;
+	length = array->length;
 }
 
 
 /// __________________________________________________
 /// Auxilliary
-inline IntegerVector prevres_intvec(DataFrame object, const char* subject, const char* timepoint, const char* result)
+inline IntegerVector prevres_intvec(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* sequence, const char* duplicates)
 {
-//	cout << "@prevres_intvec(DataFrame, const char*, const char*, const char*) subject " << subject
-//		 << "; timepoint " << timepoint << "; result " << result << endl;
+//	cout << "@prevres_intvec(DataFrame, const char*, const char*, const char*, const char*, const char*) subject " << subject
+//		 << "; timepoint " << timepoint << "; result " << result << "; sequence " << sequence << endl;
 	int testcol { colpos(object, result) };
     RObject colobj { object[testcol] };
-	IntegerVector intvec(wrap(vector<int>(Transitiondata(object, colpos(object, subject), colpos(object, timepoint), testcol).prev_result())));
+	IntegerVector intvec(wrap(vector<int>(Transitiondata(object, colpos(object, subject), colpos(object, timepoint), testcol).order_by(sequence, duplicates).prev_result())));
+	as_result(intvec, colobj);
+	return intvec;
+}
+
+
+// Give integer vector the class and levels of the result column
+inline void as_result(IntegerVector& intvec, const RObject& colobj)
+{
+//	cout << "@as_result(IntegerVector&, const RObject&)\n";
 	if (colobj.inherits("factor") && colobj.inherits("ordered"))
 		intvec.attr("class") = CharacterVector::create("factor", "ordered");
 	intvec.attr("levels") = colobj.attr("levels");
-	return intvec;
+}
+
+
+// Report percentage of rows done for a step, on completing which start a new line
+void progress_report(const char* step, long done, long total)
+{
+//	cout << "@progress_report(const char*, long, long) step " << step << "; done " << done << endl;
+	Rcerr << '\r' << step << ": " << (total ? 100 * done / total : 100) << '%' << (done == total ? "\n" : "") << std::flush;
+}
+
+
+// List of transition count, probability and intensity matrices for one stratum
+List markov_list(const Markovstats& ms, const CharacterVector& levels)
+{
+//	cout << "@markov_list(const Markovstats&, const CharacterVector&) nstates " << ms.nstates << endl;
+	int n { ms.nstates };
+	IntegerMatrix counts(n, n);
+	NumericMatrix probs(n, n), intens(n, n);
+	for (int i { 0 }; i < n; ++i) {
+		int total { 0 };
+		double rate { 0.0 };
+		for (int j { 0 }; j < n; ++j)
+			total += counts(i, j) = ms.counts[i * n + j];
+		for (int j { 0 }; j < n; ++j) {
+			probs(i, j) = total ? double(counts(i, j)) / total : NA_REAL;
+			if (i != j)
+				rate += intens(i, j) = ms.atrisk[i] > 0 ? counts(i, j) / ms.atrisk[i] : NA_REAL;
+		}
+		intens(i, i) = -rate;
+	}
+	List dimnms { List::create(_["from"] = levels, _["to"] = levels) };
+	counts.attr("dimnames") = dimnms;
+	probs.attr("dimnames") = dimnms;
+	intens.attr("dimnames") = dimnms;
+	NumericVector atrisk(wrap(ms.atrisk));
+	atrisk.attr("names") = levels;
+	return List::create(_["counts"] = counts, _["probabilities"] = probs, _["time_at_risk"] = atrisk, _["intensities"] = intens);
+}
+
+
+// Address of an Arrow C struct given as an external pointer, or a numeric or character address
+void* arrow_address(SEXP ptr)
+{
+//	cout << "@arrow_address(SEXP)\n";
+	void* addr { nullptr };
+	if (TYPEOF(ptr) == EXTPTRSXP)
+		addr = R_ExternalPtrAddr(ptr);
+	else if (TYPEOF(ptr) == REALSXP && Rf_length(ptr) == 1)
+		addr = reinterpret_cast<void*>(uintptr_t(REAL(ptr)[0]));
+	else if (TYPEOF(ptr) == STRSXP && Rf_length(ptr) == 1)
+		addr = reinterpret_cast<void*>(uintptr_t(std::stoull(CHAR(STRING_ELT(ptr, 0)))));
+	if (!addr)
+		throw std::invalid_argument("Arrow C struct address neither a valid external pointer, number nor string");
+	return addr;
+}
+
+
+// ArrowArray (element 0) or ArrowSchema (element 1) of a list of two addresses
+template<class T>
+T* arrow_struct(const List& pair, int elem, const char* argname)
+{
+//	cout << "@arrow_struct<T>(const List&, int, const char*) argname " << argname << endl;
+	if (pair.size() != 2)
+		throw std::invalid_argument(string("\"") + argname + "\" not a list of an ArrowArray and an ArrowSchema");
+	return static_cast<T*>(arrow_address(pair[elem]));
+}
+
+
+// Release callbacks for exported Arrow C structs
+static void release_array(ArrowArray* array)
+{
+	delete static_cast<Arrowbuffers*>(array->private_data);
+	array->release = nullptr;
+}
+
+static void release_schema(ArrowSchema* schema)
+{
+	delete static_cast<string*>(schema->private_data);
+	schema->release = nullptr;
+}
+
+
+// Check that an Arrow array and schema given as a list of two addresses are empty, ready to receive output
+void arrow_check_empty(SEXP pairobj, const char* name)
+{
+//	cout << "@arrow_check_empty(SEXP, const char*) name " << name << endl;
+	List pair(pairobj);
+	if (arrow_struct<ArrowArray>(pair, 0, name)->release || arrow_struct<ArrowSchema>(pair, 1, name)->release)
+		throw std::invalid_argument(string("\"") + name + "\" Arrow C structs not empty");
+}
+
+
+// Move integer values, NAs as nulls, into an Arrow array given as a list of two addresses
+void arrow_export(vector<int> values, const char* format, const char* name, SEXP pairobj)
+{
+//	cout << "@arrow_export(vector<int>, const char*, const char*, SEXP) name " << name << endl;
+	arrow_check_empty(pairobj, name);
+	List pair(pairobj);
+	auto array { arrow_struct<ArrowArray>(pair, 0, name) };
+	auto schema { arrow_struct<ArrowSchema>(pair, 1, name) };
+
+	int64_t length = values.size(), nulls { 0 };
+	auto bufs { new Arrowbuffers { vector<uint8_t>((length + 7) / 8), std::move(values), {} } };
+	for (int64_t i { 0 }; i < length; ++i) {
+		if (NA_INTEGER == bufs->data[i]) {
+			bufs->data[i] = 0;
+			++nulls;
+		} else
+			bufs->valid[i >> 3] |= 1 << (i & 7);
+	}
+	bufs->buffers[0] = nulls ? bufs->valid.data() : nullptr;
+	bufs->buffers[1] = bufs->data.data();
+	*array = ArrowArray { length, nulls, 0, 2, 0, bufs->buffers, nullptr, nullptr, release_array, bufs };
+
+	auto schemaname { new string(name) };
+	*schema = ArrowSchema { format, schemaname->c_str(), nullptr, ARROW_FLAG_NULLABLE, 0, nullptr, nullptr, release_schema, schemaname };
+}
+
+
+// Data frame of rolling window statistics, column names optionally prefixed
+DataFrame rolling_df(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* prefix, int window, const char* unit, int positive, const char* sequence, const char* duplicates)
+{
+//	cout << "@rolling_df(DataFrame, const char*, const char*, const char*, const char*, int, const char*, int, const char*, const char*) unit " << unit << endl;
+	string unitstr { str_tolower(unit) };
+	if (unitstr != "tests" && unitstr != "days")
+		throw std::invalid_argument("\"unit\" must be either \"tests\" or \"days\"");
+	int testcol { colpos(object, result) };
+	RObject colobj { object[testcol] };
+	Rollstats rs { Transitiondata(object, colpos(object, subject), colpos(object, timepoint), testcol).order_by(sequence, duplicates).rolling(window, unitstr == "days", positive) };
+	IntegerVector maxvec(wrap(rs.max)), minvec(wrap(rs.min));
+	as_result(maxvec, colobj);
+	as_result(minvec, colobj);
+	string pre { *prefix ? string(prefix) + "_" : string() };
+	DataFrame out { DataFrame::create(
+		_[pre + "max"] = maxvec,
+		_[pre + "min"] = minvec,
+		_[pre + "mean"] = rs.mean,
+		_[pre + "n"] = rs.n,
+		_[pre + "positive"] = rs.pos
+	) };
+	return out;
 }
 
 
@@ -289,9 +539,8 @@ inline IntegerVector prevres_intvec(DataFrame object, const char* subject, const
 //' @details
 //' The data can be presented in any order e.g., ordered by \code{subject}, by \code{timepoint},
 //' forwards or backwards in time, or entirely at random, and may have unbalanced designs with different
-//' time points or numbers of test results per subject. However, the \emph{user} is responsible for
-//' ensuring the data contain unique combinations of \code{subject}, \code{timepoint} and \code{result};
-//' if not, outputs will be undefined.
+//' time points or numbers of test results per subject. Tests of a subject sharing a time point are
+//' ordered and represented as set out below by \code{sequence} and \code{duplicates}.
 //'
 //' Time points should be formatted as \code{\link{Dates}} and included in data frame \code{object} in
 //' the column named as specified by argument \code{timepoint} (see \emph{Note}).
@@ -309,6 +558,12 @@ inline IntegerVector prevres_intvec(DataFrame object, const char* subject, const
 //' subjected to integer division by that value. Finally, if \code{cap} is a positive, non-zero
 //' integer, the (possibly modulated) absolute arithmetic difference is capped at that value.
 //'
+//' Tests of a subject at the same time point are ordered by \code{sequence} if specified, and
+//' otherwise are regarded as duplicates, as are those with the same time point and \code{sequence}.
+//' The previous test of the tests following a set of duplicates is taken to be the first of them in
+//' row order if \code{duplicates} is \code{"first"} (the default), the last if \code{"last"}, or that
+//' with the highest result if \code{"aggregate"}; while \code{"error"} disallows duplicates.
+//'
 //' @family transitions
 //' @seealso
 //' \code{\link{data.frame}}, \code{\link{Dates}}, and \code{\link[base:factor]{ordered factor}}.
@@ -332,6 +587,16 @@ inline IntegerVector prevres_intvec(DataFrame object, const char* subject, const
 //'
 //' @param modulate \code{\link{integer}}, required for calculating transitions; default \code{0L}.
 //'
+//' @param progress \code{\link{logical}}, whether to report progress through each step of the
+//'   calculation; default \code{FALSE}.
+//'
+//' @param sequence \code{character}, name of an optional column (of type \code{\link{integer}} or
+//'   \code{\link{numeric}}) ordering tests of a subject at the same time point, e.g. a sample
+//'   sequence number; default \code{""}, none.
+//'
+//' @param duplicates \code{character}, treatment of duplicate tests, either \code{"error"},
+//'   \code{"first"}, \code{"last"} or \code{"aggregate"}, see \emph{Details}; default \code{"first"}.
+//'
 //' @return
 //'
 //' \item{\code{add_transitions()}}{A \code{\link{data.frame}} based on \code{object}, with an added
@@ -352,6 +617,12 @@ inline IntegerVector prevres_intvec(DataFrame object, const char* subject, const
 //' Quantitive results available as \code{\link{numeric}} data can be converted to a semi-quantitative
 //'   \code{\link[base:factor]{ordered factor}} conveniently using \code{\link{cut}()} (see \emph{examples}).
 //'
+//' User interrupts are checked for after ordering the rows, between chunks of subjects while finding
+//'   previous tests and between chunks of rows while computing transitions, so that long calculations
+//'   on very large data frames may be cancelled with \kbd{Esc} or \kbd{Ctrl-C} at those points. Ordering
+//'   itself is not interrupted, nor are \code{\link{get_rolling}()}, \code{\link{get_markov}()},
+//'   \code{\link{get_ngrams}()} or \code{\link{get_first_transition}()}.
+//'
 //' @examples
 //'
 //'   # Inspect Blackmore data frame using {base} str()
@@ -407,12 +678,15 @@ DataFrame add_transitions(
 	const char* result = "result",
 	const char* transition = "transition",
 	int cap = 0,
-	int modulate = 0)
+	int modulate = 0,
+	bool progress = false,
+	const char* sequence = "",
+	const char* duplicates = "first")
 {
-//	cout << "——Rcpp::export——add_transitions(DataFrame, const char*, const char*, const char*, const char*, int) subject " << subject
+//	cout << "——Rcpp::export——add_transitions(DataFrame, const char*, const char*, const char*, const char*, int, int, bool, const char*, const char*) subject " << subject
 //		 << "; timepoint " << timepoint << "; result " << result << "; transition " << transition << endl;
 	try {
-		return Transitiondata(object, colpos(object, subject), colpos(object, timepoint), colpos(object, result)).add_transition(transition, cap, modulate);
+		return Transitiondata(object, colpos(object, subject), colpos(object, timepoint), colpos(object, result)).report_progress(progress).order_by(sequence, duplicates).add_transition(transition, cap, modulate);
 	} catch (exception& e) {
 		Rcerr << "Error in add_transitions(): " << e.what() << '\n';
 	} catch (std::invalid_argument& iva) {
@@ -430,12 +704,15 @@ IntegerVector get_transitions(
 	const char* timepoint = "timepoint",
 	const char* result = "result",
 	int cap = 0,
-	int modulate = 0)
+	int modulate = 0,
+	bool progress = false,
+	const char* sequence = "",
+	const char* duplicates = "first")
 {
-//	cout << "——Rcpp::export——get_transitions(DataFrame, const char*, const char*, const char*, int) subject " << subject
+//	cout << "——Rcpp::export——get_transitions(DataFrame, const char*, const char*, const char*, int, int, bool, const char*, const char*) subject " << subject
 //		 << "; timepoint " << timepoint << "; result " << result << endl;
 	try {
-		return wrap(Transitiondata(object, colpos(object, subject), colpos(object, timepoint), colpos(object, result)).get_transition(cap, modulate));
+		return wrap(Transitiondata(object, colpos(object, subject), colpos(object, timepoint), colpos(object, result)).report_progress(progress).order_by(sequence, duplicates).get_transition(cap, modulate));
 	} catch (exception& e) {
 		Rcerr << "Error in get_transitions(): " << e.what() << '\n';
 	} catch (std::invalid_argument& iva) {
@@ -505,12 +782,14 @@ DataFrame add_prev_date(
 	DataFrame object, const char* subject = "subject",
 	const char* timepoint = "timepoint",
 	const char* result = "result",
-	const char* prev_date = "prev_date")
+	const char* prev_date = "prev_date",
+	const char* sequence = "",
+	const char* duplicates = "first")
 {
-//	cout << "——Rcpp::export——add_prev_date(DataFrame, const char*, const char*, const char*) subject "
+//	cout << "——Rcpp::export——add_prev_date(DataFrame, const char*, const char*, const char*, const char*, const char*, const char*) subject "
 //	<< subject << "; timepoint " << timepoint << "; result " << result << "; prev_date " << prev_date << endl;
 	try {
-        	object.push_back(DateVector(wrap(Transitiondata(object, colpos(object, subject), colpos(object, timepoint), colpos(object, result)).prev_date())), prev_date);
+        	object.push_back(DateVector(wrap(Transitiondata(object, colpos(object, subject), colpos(object, timepoint), colpos(object, result)).order_by(sequence, duplicates).prev_date())), prev_date);
  	return object;
 	} catch (exception& e) {
         	Rcerr << "Error in add_prev_date(): " << e.what() << '\n';
@@ -523,11 +802,11 @@ DataFrame add_prev_date(
 
 //' @rdname PreviousDate
 // [[Rcpp::export]]
-DateVector get_prev_date(DataFrame object, const char* subject = "subject", const char* timepoint = "timepoint", const char* result = "result")
+DateVector get_prev_date(DataFrame object, const char* subject = "subject", const char* timepoint = "timepoint", const char* result = "result", const char* sequence = "", const char* duplicates = "first")
 {
-//	cout << "——Rcpp::export——get_prev_date(DataFrame, const char*, const char*, const char*) subject " << subject << "; timepoint " << timepoint << "; result " << result << endl;
+//	cout << "——Rcpp::export——get_prev_date(DataFrame, const char*, const char*, const char*, const char*, const char*) subject " << subject << "; timepoint " << timepoint << "; result " << result << endl;
 	try {
-		return wrap(Transitiondata(object, colpos(object, subject), colpos(object, timepoint), colpos(object, result)).prev_date());
+		return wrap(Transitiondata(object, colpos(object, subject), colpos(object, timepoint), colpos(object, result)).order_by(sequence, duplicates).prev_date());
 	} catch (exception& e) {
 		Rcerr << "Error in get_prev_date(): " << e.what() << '\n';
 	} catch (std::invalid_argument& iva) {
@@ -598,13 +877,15 @@ DataFrame add_prev_result(
 	const char* subject = "subject",
 	const char* timepoint = "timepoint",
 	const char* result = "result",
-	const char* prev_result = "prev_result"
+	const char* prev_result = "prev_result",
+	const char* sequence = "",
+	const char* duplicates = "first"
 )
 {
-//	cout << "——Rcpp::export——add_prev_result(DataFrame, const char*, const char*, const char*, const char*) subject "
+//	cout << "——Rcpp::export——add_prev_result(DataFrame, const char*, const char*, const char*, const char*, const char*, const char*) subject "
 //		 << subject << "; timepoint " << timepoint << "; result " << result << "; prev_result " << prev_result << endl;
 	try {
-		object.push_back(prevres_intvec(object, subject, timepoint, result), prev_result);
+		object.push_back(prevres_intvec(object, subject, timepoint, result, sequence, duplicates), prev_result);
 		return object;
 	} catch (exception& e) {
 		Rcerr << "Error in add_prev_result(): " << e.what() << '\n';
@@ -617,11 +898,11 @@ DataFrame add_prev_result(
 
 //' @rdname PreviousResult
 // [[Rcpp::export]]
-IntegerVector get_prev_result(DataFrame object, const char* subject = "subject", const char* timepoint = "timepoint", const char* result = "result")
+IntegerVector get_prev_result(DataFrame object, const char* subject = "subject", const char* timepoint = "timepoint", const char* result = "result", const char* sequence = "", const char* duplicates = "first")
 {
-//	cout << "——Rcpp::export——get_prev_result(DataFrame, const char*, const char*, const char*) subject " << subject << "; timepoint " << timepoint << "; result " << result << endl;
+//	cout << "——Rcpp::export——get_prev_result(DataFrame, const char*, const char*, const char*, const char*, const char*) subject " << subject << "; timepoint " << timepoint << "; result " << result << endl;
 	try {
-		return prevres_intvec(object, subject, timepoint, result);
+		return prevres_intvec(object, subject, timepoint, result, sequence, duplicates);
 	} catch (exception& e) {
 		Rcerr << "Error in get_prev_result(): " << e.what() << '\n';
 	} catch (std::invalid_argument& iva) {
@@ -706,3 +987,913 @@ List uniques(DataFrame object, const char* subject = "subject", const char* time
 	}
 	return List::create();
 }
+
+
+//' @title
+//' Rolling Window Statistics of Past Test Results for Subject
+//'
+//' @name
+//' Rolling
+//'
+//' @description
+//' \code{get_rolling()} calculates statistics of the test results for individual subjects in a
+//' longitudinal study over a window of their most recent tests.
+//'
+//' \code{add_rolling()} interpolates these statistics into a data frame for further analysis.
+//'
+//' @details
+//' See \code{\link{Transitions}} \emph{details}.
+//'
+//' For each test, the window comprises that test and the tests of the same subject preceding it in
+//' time. If \code{unit} is \code{"tests"}, the window holds at most \code{window} tests; if
+//' \code{unit} is \code{"days"}, it holds those tests within \code{window} days of the current test
+//' i.e., earlier by less than \code{window} days. Missing results are disregarded, while tests with
+//' a missing time point are left out of every window and have \code{NA} statistics.
+//'
+//' Tests of a subject at the same time point are ordered by \code{sequence} as for
+//' \code{\link{get_transitions}()}. Each set of duplicates enters the window as a single test, that
+//' which \code{duplicates} takes as the previous test of those following, and they all share its
+//' statistics; a window of \code{window} tests thus spans at most that many distinct time points.
+//'
+//' The maximum, minimum and mean are those of the result levels in the window, and a test is
+//' regarded as positive if its result level is at least \code{positive}. For binary results, the
+//' default \code{positive = 1L} counts results of \code{1}; for an ordered factor, \code{positive}
+//' is the number of the lowest level regarded as positive.
+//'
+//' @family transitions
+//' @seealso
+//' \code{\link{data.frame}}, \code{\link{Dates}}, \code{\link[base:factor]{ordered factor}}.
+//'
+//' @param rolling \code{character}, prefix to be used for the names of new columns to record the
+//'   rolling window statistics; default \code{"rolling"}.
+//'
+//' @param window \code{\link{integer}}, size of the window as a number of tests or days; default
+//'   \code{3L}.
+//'
+//' @param unit \code{character}, either \code{"tests"} or \code{"days"}, the unit in which
+//'   \code{window} is measured; default \code{"tests"}.
+//'
+//' @param positive \code{\link{integer}}, lowest result level regarded as positive; default
+//'   \code{1L}.
+//'
+//' @inheritParams Transitions
+//'
+//' @return
+//'
+//' \item{\code{add_rolling()}}{A \code{\link{data.frame}} based on \code{object}, with five added
+//'    columns, named using the prefix specified by argument \code{rolling}, as described below.}
+//'
+//' \item{\code{get_rolling()}}{A \code{\link{data.frame}} with \code{\link{nrow}(object)} rows ordered
+//'    in the exact sequence of the \code{subject} and \code{timepoint} in \code{object}, and columns
+//'    \code{max} and \code{min}, of the same type as \code{result}, containing the highest and lowest
+//'    results in the window, \code{mean}, of type \code{\link{numeric}}, containing the mean result
+//'    level, and \code{n} and \code{positive}, of type \code{\link{integer}}, containing the numbers
+//'    of results and of positive results in the window.}
+//'
+//' @examples
+//'
+//' \dontshow{
+//' Blackmore <- transform(Blackmore, timepoint = as.Date("2000-01-01") + round(age * 365.25),
+//'     result = cut(exercise, breaks = seq(0, 30, 2), labels = paste0("<=", seq(0, 30, 2)[-1]),
+//'         include.lowest = TRUE, ordered_result = TRUE))
+//' }
+//'
+//'  ## Continuing example from `add_transitions()`
+//'   # subject, timepoint and result arguments all defaults and required types
+//' Blackmore |> str()
+//'
+//'   # Statistics over the last three tests, regarding results above 4 hours as positive
+//' get_rolling(Blackmore, positive = 3L) |> head(22)
+//'
+//'   # Add columns of statistics over the last four years to data frame
+//' add_rolling(Blackmore, window = 4 * 365, unit = "days", positive = 3L) |> head(22)
+//'
+//' rm(Blackmore)
+//'
+// [[Rcpp::export]]
+DataFrame add_rolling(
+	DataFrame object,
+	const char* subject = "subject",
+	const char* timepoint = "timepoint",
+	const char* result = "result",
+	const char* rolling = "rolling",
+	int window = 3,
+	const char* unit = "tests",
+	int positive = 1,
+	const char* sequence = "",
+	const char* duplicates = "first")
+{
+//	cout << "——Rcpp::export——add_rolling(DataFrame, const char*, const char*, const char*, const char*, int, const char*, int, const char*, const char*) subject " << subject
+//		 << "; timepoint " << timepoint << "; result " << result << "; rolling " << rolling << endl;
+	try {
+		DataFrame stats { rolling_df(object, subject, timepoint, result, rolling, window, unit, positive, sequence, duplicates) };
+		CharacterVector names { stats.names() };
+		for (R_xlen_t i { 0 }; i < stats.size(); ++i) {
+			string colname { names[i] };
+			if (object.containsElementNamed(colname.c_str()))
+				stop("Data frame already has column named \"%s\", try another prefix", colname);
+			object.push_back(stats[i], colname);
+		}
+		return object;
+	} catch (exception& e) {
+		Rcerr << "Error in add_rolling(): " << e.what() << '\n';
+	} catch (std::invalid_argument& iva) {
+		Rcerr << "Error invalid argument: " << iva.what() << '\n';
+	}
+	return DataFrame::create();
+}
+
+
+//' @rdname Rolling
+// [[Rcpp::export]]
+DataFrame get_rolling(
+	DataFrame object,
+	const char* subject = "subject",
+	const char* timepoint = "timepoint",
+	const char* result = "result",
+	int window = 3,
+	const char* unit = "tests",
+	int positive = 1,
+	const char* sequence = "",
+	const char* duplicates = "first")
+{
+//	cout << "——Rcpp::export——get_rolling(DataFrame, const char*, const char*, const char*, int, const char*, int, const char*, const char*) subject " << subject
+//		 << "; timepoint " << timepoint << "; result " << result << endl;
+	try {
+		return rolling_df(object, subject, timepoint, result, "", window, unit, positive, sequence, duplicates);
+	} catch (exception& e) {
+		Rcerr << "Error in get_rolling(): " << e.what() << '\n';
+	} catch (std::invalid_argument& iva) {
+		Rcerr << "Error invalid argument: " << iva.what() << '\n';
+	}
+	return DataFrame::create();
+}
+
+
+//' @title
+//' Estimate Markov Transition Probabilities and Intensities Between Test Results
+//'
+//' @name
+//' Markov
+//'
+//' @description
+//' \code{get_markov()} estimates discrete-time transition probabilities and continuous-time
+//' transition intensities between the levels of test results for individual subjects in a
+//' longitudinal study, optionally stratified by a covariate.
+//'
+//' @details
+//' See \code{\link{Transitions}} \emph{details}.
+//'
+//' Each test result is paired with the previous test result for the same subject, as identified by
+//' \code{\link{get_prev_result}()}, and the number of transitions from each result level to each
+//' other level is counted. Empirical transition probabilities are these counts divided by the total
+//' number of transitions from each level. The time at risk in each level is the sum of the
+//' intervals, in days, between the paired test dates starting in that level, and transition
+//' intensities (per day) are the counts of transitions to other levels divided by the time at risk.
+//' The diagonal of the intensity matrix is the negated sum of its other elements in each row.
+//'
+//' If \code{stratum} names a column of type \code{\link{integer}} or \code{\link{factor}}, estimates
+//' are made separately for each of its values, with each transition allocated to the stratum of
+//' the earlier of the paired tests. Transitions from tests with a missing stratum are disregarded.
+//'
+//' @family transitions
+//' @seealso
+//' \code{\link{data.frame}}, \code{\link{Dates}}, \code{\link[base:factor]{ordered factor}}.
+//'
+//' @param stratum \code{character}, name of an optional column (of type \code{\link{integer}} or
+//'   \code{\link{factor}}) by which to stratify the estimates, or \code{""} for none; default
+//'   \code{""}.
+//'
+//' @inheritParams Transitions
+//'
+//' @return
+//' A \code{\link{list}} of four elements, or if \code{stratum} is specified, a named \code{list}
+//' of such lists, one for each stratum.
+//'
+//' \item{\code{counts}}{An \code{\link{integer}} \code{\link{matrix}} of the numbers of transitions
+//'   between result levels, with rows \code{from} and columns \code{to}.}
+//'
+//' \item{\code{probabilities}}{A \code{\link{numeric}} \code{matrix} of empirical transition
+//'   probabilities.}
+//'
+//' \item{\code{time_at_risk}}{A named \code{numeric} \code{\link{vector}} of the time at risk in
+//'   days in each result level.}
+//'
+//' \item{\code{intensities}}{A \code{numeric} \code{matrix} of estimated transition intensities per
+//'   day.}
+//'
+//' @examples
+//'
+//' \dontshow{
+//' Blackmore <- transform(Blackmore, timepoint = as.Date("2000-01-01") + round(age * 365.25),
+//'     result = cut(exercise, breaks = seq(0, 30, 2), labels = paste0("<=", seq(0, 30, 2)[-1]),
+//'         include.lowest = TRUE, ordered_result = TRUE))
+//' }
+//'
+//'  ## Continuing example from `add_transitions()`
+//'   # subject, timepoint and result arguments all defaults and required types
+//' Blackmore |> str()
+//'
+//'   # Transition probabilities between result levels
+//' get_markov(Blackmore)$probabilities |> round(2)
+//'
+//'   # Transition counts stratified by group
+//' lapply(get_markov(Blackmore, stratum = "group"), `[[`, "counts")
+//'
+//' rm(Blackmore)
+//'
+// [[Rcpp::export]]
+List get_markov(
+	DataFrame object,
+	const char* subject = "subject",
+	const char* timepoint = "timepoint",
+	const char* result = "result",
+	const char* stratum = "",
+	const char* sequence = "",
+	const char* duplicates = "first")
+{
+//	cout << "——Rcpp::export——get_markov(DataFrame, const char*, const char*, const char*, const char*, const char*, const char*) subject " << subject
+//		 << "; timepoint " << timepoint << "; result " << result << "; stratum " << stratum << endl;
+	try {
+		int testcol { colpos(object, result) };
+		Transitiondata td(object, colpos(object, subject), colpos(object, timepoint), testcol);
+		td.order_by(sequence, duplicates);
+		RObject colobj { object[testcol] };
+		bool isfactor { colobj.inherits("factor") };
+		CharacterVector levels { isfactor ? CharacterVector(colobj.attr("levels")) : CharacterVector::create("0", "1") };
+		if (!*stratum)
+			return markov_list(td.markov(levels.size(), int(isfactor), vector<int>(), 1)[0], levels);
+
+		RObject strobj { object[colpos(object, stratum)] };
+		if (!is<IntegerVector>(strobj))
+			throw std::invalid_argument(string("column `") + stratum + "` neither an integer nor a factor");
+		vector<int> strvec { as<vector<int>>(strobj) };
+		vector<int> strvals { get_unique(strvec) };
+		if (!strvals.empty() && NA_INTEGER == strvals.front())
+			strvals.erase(strvals.begin());
+		transform(strvec.begin(), strvec.end(), strvec.begin(), [&strvals](int val) {
+			auto it { std::lower_bound(strvals.begin(), strvals.end(), val) };
+			return (it == strvals.end() || *it != val) ? -1 : int(it - strvals.begin());
+		});
+		auto stats { td.markov(levels.size(), int(isfactor), strvec, strvals.size()) };
+		CharacterVector strlevels { strobj.inherits("factor") ? CharacterVector(strobj.attr("levels")) : CharacterVector() };
+		List out(stats.size());
+		CharacterVector strnames(stats.size());
+		for (size_t s { 0 }; s < stats.size(); ++s) {
+			out[s] = markov_list(stats[s], levels);
+			if (strlevels.size())
+				strnames[s] = strlevels[strvals[s] - 1];
+			else
+				strnames[s] = std::to_string(strvals[s]);
+		}
+		out.attr("names") = strnames;
+		return out;
+	} catch (exception& e) {
+		Rcerr << "Error in get_markov(): " << e.what() << '\n';
+	} catch (std::invalid_argument& iva) {
+		Rcerr << "Error invalid argument: " << iva.what() << '\n';
+	}
+	return List::create();
+}
+
+
+//' @title
+//' Subject-Level Bootstrap of Temporal Transitions
+//'
+//' @name
+//' Bootstrap
+//'
+//' @description
+//' \code{get_bootstrap()} estimates confidence intervals for the frequencies of temporal transitions
+//' in test results by resampling the subjects of a longitudinal study with replacement.
+//'
+//' @details
+//' See \code{\link{Transitions}} \emph{details}.
+//'
+//' Transitions are first identified as by \code{\link{get_transitions}()} and counted for each
+//' subject. In each bootstrap replicate, as many subjects as there are in \code{object} are drawn
+//' with replacement, and their counts of each transition value are summed. Each replicate uses its
+//' own random number generator seeded from \code{seed} and the number of the replicate, so that
+//' results are reproducible regardless of the number of \code{threads} over which the replicates
+//' are shared.
+//'
+//' Percentile confidence intervals are calculated from the replicates for the count and the
+//' proportion of all transitions represented by each transition value. Replicates without any
+//' transitions are omitted from the intervals for proportions, which are \code{NA} if there are none.
+//'
+//' @family transitions
+//' @seealso
+//' \code{\link{data.frame}}, \code{\link{Dates}}, \code{\link[base:factor]{ordered factor}}.
+//'
+//' @param nboot \code{\link{integer}}, number of bootstrap replicates; default \code{1000L}.
+//'
+//' @param conf \code{\link{numeric}}, confidence level of the intervals; default \code{0.95}.
+//'
+//' @param intervals \code{\link{logical}}, whether to return confidence intervals rather than the
+//'   replicates; default \code{TRUE}.
+//'
+//' @param seed \code{\link{integer}}, seed for the random number generators, or \code{NA} to draw
+//'   one from the \R random number generator (see \code{\link{set.seed}()}); default \code{NA}.
+//'
+//' @param threads \code{\link{integer}}, number of threads, or \code{0L} to use all available;
+//'   default \code{1L}.
+//'
+//' @inheritParams Transitions
+//'
+//' @return
+//'
+//' If \code{intervals} is \code{TRUE}, a \code{\link{data.frame}} with a row for each transition
+//' value observed, and columns \code{transition}, \code{count}, \code{lower} and \code{upper},
+//' giving the transition value, its observed count and confidence limits, and \code{proportion},
+//' \code{prop_lower} and \code{prop_upper}, giving its observed proportion of all transitions and
+//' confidence limits.
+//'
+//' Otherwise, an \code{\link{integer}} \code{\link{matrix}} of transition counts, with a row for each
+//' replicate and a column for each transition value observed.
+//'
+//' @examples
+//'
+//' \dontshow{
+//' Blackmore <- transform(Blackmore, timepoint = as.Date("2000-01-01") + round(age * 365.25),
+//'     result = cut(exercise, breaks = seq(0, 30, 2), labels = paste0("<=", seq(0, 30, 2)[-1]),
+//'         include.lowest = TRUE, ordered_result = TRUE))
+//' }
+//'
+//'  ## Continuing example from `add_transitions()`
+//'   # subject, timepoint and result arguments all defaults and required types
+//' Blackmore |> str()
+//'
+//'   # Confidence intervals for transitions, positive (1) or negative (-1)
+//' get_bootstrap(Blackmore, cap = 1, seed = 1L)
+//'
+//'   # Replicates of transition counts
+//' get_bootstrap(Blackmore, cap = 2, nboot = 10L, intervals = FALSE, seed = 1L, threads = 2L)
+//'
+//' rm(Blackmore)
+//'
+// [[Rcpp::export]]
+RObject get_bootstrap(
+	DataFrame object,
+	const char* subject = "subject",
+	const char* timepoint = "timepoint",
+	const char* result = "result",
+	int cap = 0,
+	int modulate = 0,
+	int nboot = 1000,
+	double conf = 0.95,
+	bool intervals = true,
+	int seed = NA_INTEGER,
+	int threads = 1,
+	const char* sequence = "",
+	const char* duplicates = "first")
+{
+//	cout << "——Rcpp::export——get_bootstrap(DataFrame, const char*, const char*, const char*, int, int, int, double, bool, int, int, const char*, const char*) subject " << subject
+//		 << "; timepoint " << timepoint << "; result " << result << "; nboot " << nboot << endl;
+	try {
+		if (nboot < 1)
+			throw std::invalid_argument("\"nboot\" less than one");
+		if (!(conf > 0 && conf < 1))
+			throw std::invalid_argument("\"conf\" not between zero and one");
+		Bootsummary bs { Transitiondata(object, colpos(object, subject), colpos(object, timepoint), colpos(object, result)).order_by(sequence, duplicates).subject_transitions(cap, modulate) };
+		unsigned useed = NA_INTEGER == seed ? unsigned(R::runif(0, 1) * UINT_MAX) : unsigned(seed);
+		if (threads < 1)
+			threads = std::thread::hardware_concurrency();
+		auto reps { bootstrap(bs, nboot, useed, threads) };
+		int nvals = bs.values.size();
+
+		if (!intervals) {
+			IntegerMatrix repmat(nboot, nvals);
+			for (int b { 0 }; b < nboot; ++b)
+				for (int v { 0 }; v < nvals; ++v)
+					repmat(b, v) = reps[b * nvals + v];
+			repmat.attr("dimnames") = List::create(R_NilValue, wrap(bs.values));
+			return repmat;
+		}
+
+		vector<int> observed(nvals);
+		for (int s { 0 }; s < bs.nsub; ++s)
+			for (int v { 0 }; v < nvals; ++v)
+				observed[v] += bs.counts[s * nvals + v];
+		double total = std::accumulate(observed.begin(), observed.end(), 0.0);
+		vector<double> reptotals(nboot);
+		for (int b { 0 }; b < nboot; ++b)
+			reptotals[b] = std::accumulate(reps.begin() + b * nvals, reps.begin() + (b + 1) * nvals, 0.0);
+		double alpha { (1 - conf) / 2 };
+		NumericVector lower(nvals), upper(nvals), prop(nvals), proplower(nvals), propupper(nvals);
+		vector<double> column(nboot), propcolumn;
+		for (int v { 0 }; v < nvals; ++v) {
+			propcolumn.clear();
+			for (int b { 0 }; b < nboot; ++b) {
+				column[b] = reps[b * nvals + v];
+				if (reptotals[b])
+					propcolumn.push_back(column[b] / reptotals[b]);
+			}
+			lower[v] = quantile(column, alpha);
+			upper[v] = quantile(column, 1 - alpha);
+			prop[v] = observed[v] / total;
+			proplower[v] = quantile(propcolumn, alpha);
+			propupper[v] = quantile(propcolumn, 1 - alpha);
+		}
+		return DataFrame::create(
+			_["transition"] = bs.values,
+			_["count"] = observed,
+			_["lower"] = lower,
+			_["upper"] = upper,
+			_["proportion"] = prop,
+			_["prop_lower"] = proplower,
+			_["prop_upper"] = propupper
+		);
+	} catch (exception& e) {
+		Rcerr << "Error in get_bootstrap(): " << e.what() << '\n';
+	} catch (std::invalid_argument& iva) {
+		Rcerr << "Error invalid argument: " << iva.what() << '\n';
+	}
+	return DataFrame::create();
+}
+
+
+//' @title
+//' Identify Temporal Transitions in Arrow Arrays
+//'
+//' @name
+//' ArrowTransitions
+//'
+//' @description
+//' \code{arrow_transitions()} identifies previous test dates, previous test results and temporal
+//' transitions in test results for individual subjects in a longitudinal study, reading and writing
+//' columns through the \href{https://arrow.apache.org/docs/format/CDataInterface.html}{Arrow C Data
+//' Interface} without conversion to \R vectors.
+//'
+//' @details
+//' See \code{\link{Transitions}} \emph{details}.
+//'
+//' Each column is specified as a \code{\link{list}} of the addresses of an \code{ArrowArray} and of
+//' an \code{ArrowSchema} C struct, given either as external pointers, or as numeric or character
+//' addresses, such as those provided by packages \pkg{arrow} or \pkg{nanoarrow}.
+//'
+//' The input arrays are read in place and are not released. The \code{subject} and \code{result}
+//' arrays should be of type int8, int16 or int32, or dictionary-encoded with indices of one of
+//' these types, and the \code{timepoint} array of type date32. For dictionary-encoded arrays,
+//' the indices are taken in the order of the dictionary, with results treated as for an
+//' \code{\link[base:factor]{ordered factor}}.
+//'
+//' Output columns are moved into the empty \code{ArrowArray} and \code{ArrowSchema} structs specified
+//' by \code{prev_date}, \code{prev_result} and \code{transition}, which become responsible for
+//' releasing them; outputs specified as \code{NULL} are not calculated. Previous test dates are of
+//' type date32, while previous test results and transitions are of type int32, with previous
+//' dictionary-encoded results as level numbers starting at \code{1}. Tests of a subject at the same
+//' time point are regarded as duplicates, the first of them in row order being the previous test of
+//' those following.
+//'
+//' @family transitions
+//' @seealso
+//' \code{\link{add_transitions}()}, \code{\link{add_prev_date}()}, \code{\link{add_prev_result}()}.
+//'
+//' @param subject \code{\link{list}} of the addresses of the \code{ArrowArray} and \code{ArrowSchema}
+//'   of the array identifying individual study subjects.
+//'
+//' @param timepoint \code{list} of the addresses of the \code{ArrowArray} and \code{ArrowSchema}
+//'   of the array recording time points of testing of subjects.
+//'
+//' @param result \code{list} of the addresses of the \code{ArrowArray} and \code{ArrowSchema}
+//'   of the array recording test results.
+//'
+//' @param prev_date \code{list} of the addresses of the empty \code{ArrowArray} and
+//'   \code{ArrowSchema} to receive the previous test dates, or \code{NULL}; default \code{NULL}.
+//'
+//' @param prev_result \code{list} of the addresses of the empty \code{ArrowArray} and
+//'   \code{ArrowSchema} to receive the previous test results, or \code{NULL}; default \code{NULL}.
+//'
+//' @param transition \code{list} of the addresses of the empty \code{ArrowArray} and
+//'   \code{ArrowSchema} to receive the transitions, or \code{NULL}; default \code{NULL}.
+//'
+//' @inheritParams Transitions
+//'
+//' @return
+//' \code{NULL}, invisibly; the outputs are written to the Arrow C structs specified.
+//'
+//' @examples
+//'
+//' if (requireNamespace("nanoarrow", quietly = TRUE)) {
+//'   Blackmore <- transform(Blackmore, timepoint = as.Date("2000-01-01") + round(age * 365.25),
+//'       result = cut(exercise, breaks = seq(0, 30, 2), labels = paste0("<=", seq(0, 30, 2)[-1]),
+//'           include.lowest = TRUE, ordered_result = TRUE))
+//'
+//'   # Arrow arrays and their schemas for the subject, timepoint and result columns
+//'   arrays <- lapply(Blackmore[c("subject", "timepoint", "result")], nanoarrow::as_nanoarrow_array)
+//'   cols <- lapply(arrays, \(a) list(a, nanoarrow::infer_nanoarrow_schema(a)))
+//'
+//'   # Empty Arrow structs to receive the transitions
+//'   out <- list(nanoarrow::nanoarrow_allocate_array(), nanoarrow::nanoarrow_allocate_schema())
+//'
+//'   arrow_transitions(cols$subject, cols$timepoint, cols$result, transition = out)
+//'   nanoarrow::nanoarrow_array_set_schema(out[[1]], out[[2]])
+//'   as.vector(out[[1]]) |> head(22)
+//'
+//'   rm(Blackmore, arrays, cols, out)
+//' }
+//'
+// [[Rcpp::export]]
+void arrow_transitions(
+	List subject,
+	List timepoint,
+	List result,
+	Nullable<List> prev_date = R_NilValue,
+	Nullable<List> prev_result = R_NilValue,
+	Nullable<List> transition = R_NilValue,
+	int cap = 0,
+	int modulate = 0)
+{
+//	cout << "——Rcpp::export——arrow_transitions(List, List, List, Nullable<List>, Nullable<List>, Nullable<List>, int, int)\n";
+	try {
+		Arrowcolumn<int> id(arrow_struct<ArrowArray>(subject, 0, "subject"), arrow_struct<ArrowSchema>(subject, 1, "subject"), false, "subject");
+		Arrowcolumn<double> testdate(arrow_struct<ArrowArray>(timepoint, 0, "timepoint"), arrow_struct<ArrowSchema>(timepoint, 1, "timepoint"), true, "timepoint");
+		Arrowcolumn<int> testresult(arrow_struct<ArrowArray>(result, 0, "result"), arrow_struct<ArrowSchema>(result, 1, "result"), false, "result");
+		if (id.size() != testdate.size() || id.size() != testresult.size())
+			throw std::invalid_argument("Arrow arrays of different lengths");
+		if (id.size() > INT_MAX)
+			throw std::invalid_argument("Arrow arrays too long");
+		if (prev_date.isNotNull())
+			arrow_check_empty(prev_date.get(), "prev_date");
+		if (prev_result.isNotNull())
+			arrow_check_empty(prev_result.get(), "prev_result");
+		if (transition.isNotNull())
+			arrow_check_empty(transition.get(), "transition");
+
+		int nrows = id.size();
+		auto prevrow { prev_rows(id, testdate, nrows) };
+		vector<int> prevdate, prevres, transitions;
+		if (prev_date.isNotNull()) {
+			prevdate.resize(nrows);
+			transform(prevrow.begin(), prevrow.end(), prevdate.begin(), [&testdate](int row) {
+				return (row < 0 || std::isnan(testdate[row])) ? NA_INTEGER : int(testdate[row]);
+			});
+		}
+		if (prev_result.isNotNull()) {
+			prevres.resize(nrows);
+			transform(prevrow.begin(), prevrow.end(), prevres.begin(), [&testresult](int row) { return row < 0 ? NA_INTEGER : testresult[row]; });
+		}
+		if (transition.isNotNull())
+			transitions = transition_rows(prevrow, testresult, cap, modulate);
+
+		if (prev_date.isNotNull())
+			arrow_export(std::move(prevdate), "tdD", "prev_date", prev_date.get());
+		if (prev_result.isNotNull())
+			arrow_export(std::move(prevres), "i", "prev_result", prev_result.get());
+		if (transition.isNotNull())
+			arrow_export(std::move(transitions), "i", "transition", transition.get());
+	} catch (exception& e) {
+		Rcerr << "Error in arrow_transitions(): " << e.what() << '\n';
+	} catch (std::invalid_argument& iva) {
+		Rcerr << "Error invalid argument: " << iva.what() << '\n';
+	}
+}
+
+
+//' @title
+//' Count Sequences of Consecutive Test Results Across Subjects
+//'
+//' @name
+//' Ngrams
+//'
+//' @description
+//' \code{get_ngrams()} counts the occurrences of every sequence of a given number of consecutive test
+//' results for individual subjects in a longitudinal study, identifying common paths of progression.
+//'
+//' @details
+//' See \code{\link{Transitions}} \emph{details}.
+//'
+//' The test results of each subject are taken in order of time point, and a window of \code{k}
+//' consecutive results is moved along them, counting each sequence of results seen in the window.
+//' Sequences including a missing result are disregarded, as are tests with a missing time point.
+//' Tests of a subject at the same time point are ordered by \code{sequence}, and each set of
+//' duplicates contributes a single result to the sequences, that of the test chosen by
+//' \code{duplicates} as for \code{\link{get_transitions}()}. Sequences are counted over subjects
+//' shared between \code{threads}, and only those occurring at least \code{min_support} times are
+//' returned. The number of possible sequences, the number of result levels to the power \code{k},
+//' must be less than \eqn{2^{64}}{2^64}.
+//'
+//' @family transitions
+//' @seealso
+//' \code{\link{data.frame}}, \code{\link{Dates}}, \code{\link[base:factor]{ordered factor}}.
+//'
+//' @param k \code{\link{integer}}, number of consecutive test results in each sequence; default
+//'   \code{3L}.
+//'
+//' @param min_support \code{\link{integer}}, minimum count of a sequence to be returned; default
+//'   \code{1L}.
+//'
+//' @param threads \code{\link{integer}}, number of threads, or \code{0L} to use all available;
+//'   default \code{1L}.
+//'
+//' @inheritParams Transitions
+//'
+//' @return
+//' A \code{\link{data.frame}} with a row for each sequence, ordered by decreasing count, and columns
+//' \code{result1} to \code{resultk}, of the same type as \code{result}, containing the test results
+//' of the sequence in order of time point, and \code{count}, of type \code{\link{integer}},
+//' containing the number of occurrences of the sequence.
+//'
+//' @examples
+//'
+//' \dontshow{
+//' Blackmore <- transform(Blackmore, timepoint = as.Date("2000-01-01") + round(age * 365.25),
+//'     result = cut(exercise, breaks = seq(0, 30, 2), labels = paste0("<=", seq(0, 30, 2)[-1]),
+//'         include.lowest = TRUE, ordered_result = TRUE))
+//' }
+//'
+//'  ## Continuing example from `add_transitions()`
+//'   # subject, timepoint and result arguments all defaults and required types
+//' Blackmore |> str()
+//'
+//'   # Most common sequences of three consecutive results
+//' get_ngrams(Blackmore) |> head(10)
+//'
+//'   # Sequences of four consecutive results occurring at least three times
+//' get_ngrams(Blackmore, k = 4L, min_support = 3L, threads = 2L)
+//'
+//'   # Longest sequences for 15 result levels: every sequence of 16 results from a
+//'   #   repeatedly declining history also declines, wrapping from lowest to highest
+//' decline <- data.frame(subject = 1L, timepoint = as.Date("2000-01-01") + 0:39,
+//'     result = factor(15 - 0:39 %% 15, levels = 1:15, ordered = TRUE))
+//' ng <- get_ngrams(decline, k = 16L)
+//' stopifnot(nrow(ng) == 15L,
+//'     apply(sapply(ng[1:16], as.integer), 1, function(r) all(diff(r) %in% c(-1L, 14L))))
+//'
+//' rm(Blackmore, decline, ng)
+//'
+// [[Rcpp::export]]
+DataFrame get_ngrams(
+	DataFrame object,
+	const char* subject = "subject",
+	const char* timepoint = "timepoint",
+	const char* result = "result",
+	int k = 3,
+	int min_support = 1,
+	int threads = 1,
+	const char* sequence = "",
+	const char* duplicates = "first")
+{
+//	cout << "——Rcpp::export——get_ngrams(DataFrame, const char*, const char*, const char*, int, int, int, const char*, const char*) subject " << subject
+//		 << "; timepoint " << timepoint << "; result " << result << "; k " << k << endl;
+	try {
+		int testcol { colpos(object, result) };
+		RObject colobj { object[testcol] };
+		bool isfactor { colobj.inherits("factor") };
+		int nlevels { isfactor ? int(CharacterVector(colobj.attr("levels")).size()) : 2 };
+		if (threads < 1)
+			threads = std::thread::hardware_concurrency();
+		auto counts { Transitiondata(object, colpos(object, subject), colpos(object, timepoint), testcol).order_by(sequence, duplicates).ngrams(k, nlevels, int(isfactor), min_support, threads) };
+
+		List out;
+		vector<uint64_t> keys(counts.size());
+		transform(counts.begin(), counts.end(), keys.begin(), [](const std::pair<uint64_t, int>& kv) { return kv.first; });
+		uint64_t place { 1 };
+		for (int i { 1 }; i < k; ++i)
+			place *= nlevels;
+		for (int i { 0 }; i < k; ++i, place /= nlevels) {
+			IntegerVector step(counts.size());
+			for (size_t j { 0 }; j < keys.size(); ++j)
+				step[j] = keys[j] / place % nlevels + int(isfactor);
+			as_result(step, colobj);
+			out.push_back(step, "result" + std::to_string(i + 1));
+		}
+		IntegerVector countvec(counts.size());
+		transform(counts.begin(), counts.end(), countvec.begin(), [](const std::pair<uint64_t, int>& kv) { return kv.second; });
+		out.push_back(countvec, "count");
+		return DataFrame(out);
+	} catch (exception& e) {
+		Rcerr << "Error in get_ngrams(): " << e.what() << '\n';
+	} catch (std::invalid_argument& iva) {
+		Rcerr << "Error invalid argument: " << iva.what() << '\n';
+	}
+	return DataFrame::create();
+}
+
+
+//' @title
+//' Time to First Transition for Subject
+//'
+//' @name
+//' FirstTransition
+//'
+//' @description
+//' \code{get_first_transition()} calculates the time from the first test of each individual subject
+//' in a longitudinal study to their first temporal transition in test results of a given direction
+//' and magnitude, in a form ready for survival analysis.
+//'
+//' @details
+//' See \code{\link{Transitions}} \emph{details}.
+//'
+//' Transitions are identified as by \code{\link{get_transitions}()}, using the same \code{cap},
+//' \code{modulate}, \code{sequence} and \code{duplicates} arguments. The first transition of each
+//' subject in order of time point that is in the given \code{direction}, and of absolute value at
+//' least \code{magnitude}, is regarded as the event. Subjects without such a transition are
+//' censored at their last test.
+//'
+//' @family transitions
+//' @seealso
+//' \code{\link{data.frame}}, \code{\link{Dates}}, \code{\link[base:factor]{ordered factor}}.
+//'
+//' @param direction \code{character}, either \code{"up"}, \code{"down"} or \code{"any"}, the
+//'   direction of transitions regarded as events; default \code{"any"}.
+//'
+//' @param magnitude \code{\link{integer}}, the minimum absolute value of transitions regarded as
+//'   events; default \code{1L}.
+//'
+//' @inheritParams Transitions
+//'
+//' @return
+//' A \code{\link{data.frame}} with a row for each subject and columns \code{subject}, of the same type
+//' as \code{subject}, \code{start}, of class \code{\link{Date}}, containing the time point of the
+//' first test, \code{time}, of type \code{\link{numeric}}, containing the time in days from the first
+//' test to the event or censoring, \code{status}, of type \code{\link{integer}}, containing \code{1}
+//' for an event or \code{0} if censored, and \code{transition}, of type \code{integer}, containing
+//' the value of the transition, or \code{NA} if censored.
+//'
+//' @examples
+//'
+//' \dontshow{
+//' Blackmore <- transform(Blackmore, timepoint = as.Date("2000-01-01") + round(age * 365.25),
+//'     result = cut(exercise, breaks = seq(0, 30, 2), labels = paste0("<=", seq(0, 30, 2)[-1]),
+//'         include.lowest = TRUE, ordered_result = TRUE))
+//' }
+//'
+//'  ## Continuing example from `add_transitions()`
+//'   # subject, timepoint and result arguments all defaults and required types
+//' Blackmore |> str()
+//'
+//'   # Time to first transition in either direction
+//' get_first_transition(Blackmore) |> head(10)
+//'
+//'   # Time to first increase of at least two levels
+//' get_first_transition(Blackmore, direction = "up", magnitude = 2L) |> head(10)
+//'
+//'   # Time to first increase of at least three levels, which modulate = 2 rounds up to 2 or more
+//' get_first_transition(Blackmore, modulate = 2, direction = "up", magnitude = 2L) |> head(10)
+//'
+//' rm(Blackmore)
+//'
+// [[Rcpp::export]]
+DataFrame get_first_transition(
+	DataFrame object,
+	const char* subject = "subject",
+	const char* timepoint = "timepoint",
+	const char* result = "result",
+	int cap = 0,
+	int modulate = 0,
+	const char* direction = "any",
+	int magnitude = 1,
+	const char* sequence = "",
+	const char* duplicates = "first")
+{
+//	cout << "——Rcpp::export——get_first_transition(DataFrame, const char*, const char*, const char*, int, int, const char*, int, const char*, const char*) subject " << subject
+//		 << "; timepoint " << timepoint << "; result " << result << "; direction " << direction << endl;
+	try {
+		string dirstr { str_tolower(direction) };
+		if (dirstr != "up" && dirstr != "down" && dirstr != "any")
+			throw std::invalid_argument("\"direction\" must be \"up\", \"down\" or \"any\"");
+		int subcol { colpos(object, subject) };
+		Firststats fs { Transitiondata(object, subcol, colpos(object, timepoint), colpos(object, result))
+			.order_by(sequence, duplicates).first_transition(cap, modulate, (dirstr == "up") - (dirstr == "down"), magnitude) };
+		IntegerVector subvec(wrap(fs.subject));
+		RObject subobj { object[subcol] };
+		if (subobj.inherits("factor")) {
+			subvec.attr("class") = string { "factor" };
+			subvec.attr("levels") = subobj.attr("levels");
+		}
+		return DataFrame::create(
+			_[subject] = subvec,
+			_["start"] = DateVector(wrap(fs.start)),
+			_["time"] = fs.time,
+			_["status"] = fs.status,
+			_["transition"] = fs.transition
+		);
+	} catch (exception& e) {
+		Rcerr << "Error in get_first_transition(): " << e.what() << '\n';
+	} catch (std::invalid_argument& iva) {
+		Rcerr << "Error invalid argument: " << iva.what() << '\n';
+	}
+	return DataFrame::create();
+}
+
+
+//' @title
+//' Cache Groupings of Subjects and Time Points
+//'
+//' @name
+//' TransitionCache
+//'
+//' @description
+//' \code{transition_cache()} enables or disables a cache of the ordering of rows by subject and
+//' time point, with the results in that order and the previous row for each row, reused by
+//' subsequent calls on the same data.
+//'
+//' \code{transition_cache_info()} reports the state of the cache.
+//'
+//' \code{transition_cache_clear()} empties the cache and resets its statistics.
+//'
+//' @details
+//' Every function in the package first orders the rows of \code{object} by subject and time
+//' point, then finds the previous test of each row. With the cache enabled, these are kept and
+//' reused by later calls on the same \code{subject}, \code{timepoint} and \code{result} columns,
+//' whatever the values of \code{cap} and \code{modulate}, so that repeated calls of e.g.
+//' \code{\link{get_transitions}()} with different arguments recalculate only the transitions
+//' themselves.
+//'
+//' Columns are identified by their addresses in memory, lengths and a sample of their values, and
+//' each entry holds a reference to its columns, so that they are not freed and their addresses
+//' reused while cached. As R copies columns on modification, this is sufficient in ordinary use;
+//' but if columns are modified in place, for instance by \code{data.table::set()}, the cache should
+//' be cleared. Columns converted by each call, such as \code{Date} columns of type integer, are
+//' identified as given rather than as converted.
+//'
+//' The least recently used entries are discarded to keep the total size within \code{max_size};
+//' groupings larger than \code{max_size} are not cached. The cache is disabled by default.
+//'
+//' @family transitions
+//' @seealso
+//' \code{\link{data.frame}}.
+//'
+//' @param enable \code{\link{logical}}, whether to enable the cache; default \code{TRUE}.
+//'   Disabling the cache also empties it.
+//'
+//' @param max_size \code{\link{numeric}}, the maximum size of the cache in megabytes; default
+//'   \code{256}.
+//'
+//' @return
+//' \code{transition_cache()} and \code{transition_cache_clear()} are called for their side
+//' effects and return \code{NULL} invisibly.
+//'
+//' \code{transition_cache_info()} returns a \code{\link{list}} with elements \code{enabled},
+//' \code{entries}, the number of groupings cached, \code{size} and \code{max_size}, the current
+//' and maximum size of the cache in megabytes, and \code{hits} and \code{misses}, the number of
+//' calls that found or did not find their grouping in the cache.
+//'
+//' @examples
+//'
+//' \dontshow{
+//' Blackmore <- transform(Blackmore, timepoint = as.Date("2000-01-01") + round(age * 365.25),
+//'     result = cut(exercise, breaks = seq(0, 30, 2), labels = paste0("<=", seq(0, 30, 2)[-1]),
+//'         include.lowest = TRUE, ordered_result = TRUE))
+//' }
+//'
+//'  ## Continuing example from `add_transitions()`
+//'   # subject, timepoint and result arguments all defaults and required types
+//' Blackmore |> str()
+//'
+//' transition_cache()
+//'
+//'   # Grouping calculated on first call, then reused
+//' get_transitions(Blackmore) |> table()
+//' get_transitions(Blackmore, cap = 1) |> table()
+//' get_transitions(Blackmore, modulate = 2) |> table()
+//' get_prev_date(Blackmore) |> head(10)
+//'
+//' transition_cache_info() |> str()
+//'
+//' transition_cache_clear()
+//' transition_cache(FALSE)
+//'
+//' rm(Blackmore)
+//'
+// [[Rcpp::export]]
+void transition_cache(bool enable = true, double max_size = 256)
+{
+//	cout << "——Rcpp::export——transition_cache(bool, double) enable " << enable << "; max_size " << max_size << endl;
+	try {
+		if (!(max_size >= 0))
+			throw std::invalid_argument("\"max_size\" less than zero");
+		groupcache.enable(enable, size_t(max_size * (1 << 20)));
+	} catch (exception& e) {
+		Rcerr << "Error in transition_cache(): " << e.what() << '\n';
+	} catch (std::invalid_argument& iva) {
+		Rcerr << "Error invalid argument: " << iva.what() << '\n';
+	}
+}
+
+
+//' @rdname TransitionCache
+// [[Rcpp::export]]
+List transition_cache_info()
+{
+//	cout << "——Rcpp::export——transition_cache_info()\n";
+	Groupcache::Info info { groupcache.info() };
+	return List::create(
+		_["enabled"] = info.enabled,
+		_["entries"] = info.entries,
+		_["size"] = double(info.bytes) / (1 << 20),
+		_["max_size"] = double(info.maxbytes) / (1 << 20),
+		_["hits"] = double(info.hits),
+		_["misses"] = double(info.misses)
+	);
+}
+
+
+//' @rdname TransitionCache
+// [[Rcpp::export]]
+void transition_cache_clear()
+{
+//	cout << "——Rcpp::export——transition_cache_clear()\n";
+	groupcache.clear();
+}
@@ -25,24 +25,29 @@ inline std::vector<U> get_vec_attr(const T&, const char*);
 template<class T>
 inline std::string str_tolower(std::string);
 int colpos(const DataFrame, const char*);
-template<class T>
-std::vector<T> get_unique(const std::vector<T>);
-inline int adjust(int, int, int);
 
 /// Class Transitiondata
 
 class Transitiondata {
 	DataFrame df;
+	const RObject idsrc, datesrc, testsrc;
 	const IntegerVector id;
 	const DateVector testdate;
 	const IntegerVector testresult;
 	int nrows = df.nrows();
+	NumericVector sequence;
+	RObject seqsrc;
+	Duplicates dups = Duplicates::first;
+	mutable std::shared_ptr<const Grouped> grouped;
+	Progress progress = [](const char*, long, long) { checkUserInterrupt(); };
 	template<typename T>
 	T typechecker(int, int);
+	const Grouped& grouping() const;
+	const std::vector<int>& prev_row() const;
 
 public:
 	explicit Transitiondata(DataFrame _df, int idcol, int datecol, int testcol) :
-		df(_df), id(typechecker<IntegerVector>(idcol, 1)), testdate(typechecker<DateVector>(datecol, 2)), testresult(typechecker<IntegerVector>(testcol, 3))
+		df(_df), idsrc(_df[idcol]), datesrc(_df[datecol]), testsrc(_df[testcol]), id(typechecker<IntegerVector>(idcol, 1)), testdate(typechecker<DateVector>(datecol, 2)), testresult(typechecker<IntegerVector>(testcol, 3))
 		{
 //			std::cout << "§Transitiondata::Transitiondata(const DataFrame, int, int, int) "; _ctrsgn(typeid(*this));
 		}
@@ -50,31 +55,91 @@ public:
 	~Transitiondata() = default;
 //	~Transitiondata() { std::cout << "§Transitiondata::~Transitiondata() "; _ctrsgn(typeid(*this), true); }
 
-	std::vector<int> unique_sub() const { return get_unique(as<std::vector<int>>(id)); }
+	Transitiondata& report_progress(bool);
+	Transitiondata& order_by(const char*, const char*);
+	std::vector<int> unique_sub() const;
 	DateVector unique_date() const { return wrap(get_unique(as<std::vector<double>>(testdate))); }
 	std::vector<int> unique_test() const { return get_unique(as<std::vector<int>>(testresult)); }
 
-	int get_result(int, double) const;
-	std::vector<double> get_id_dates(int) const;
-	double get_prevdate(int, double) const;
 	std::vector<double> prev_date() const;
 	std::vector<int> prev_result() const;
 	DataFrame add_transition(const char* colname, int, int);
 	std::vector<int> get_transition(int, int) const;
+	Rollstats rolling(int, bool, int) const;
+	std::vector<Markovstats> markov(int, int, const std::vector<int>&, int) const;
+	Bootsummary subject_transitions(int, int) const;
+	std::vector<std::pair<uint64_t, int>> ngrams(int, int, int, int, int) const;
+	Firststats first_transition(int, int, int, int) const;
+};
+
+
+/// Class Arrowcolumn
+
+template<typename U>
+class Arrowcolumn {
+	const uint8_t* valid = nullptr;
+	const void* data = nullptr;
+	int64_t offset = 0;
+	int64_t length = 0;
+	int width = 4;
+	int add = 0;
+
+public:
+	Arrowcolumn(const ArrowArray*, const ArrowSchema*, bool, const char*);
+	int64_t size() const { return length; }
+
+	U operator[](int64_t i) const
+	{
+		i += offset;
+		if (valid && !(valid[i >> 3] >> (i & 7) & 1))
+			return std::is_same<U, double>::value ? U(NA_REAL) : U(NA_INTEGER);
+		switch (width) {
+			case 1: return static_cast<const int8_t*>(data)[i] + add;
+			case 2: return static_cast<const int16_t*>(data)[i] + add;
+			default: return static_cast<const int32_t*>(data)[i] + add;
+		}
+	}
+};
+
+/// Struct Arrowbuffers
+
+struct Arrowbuffers {
+	std::vector<uint8_t> valid;
+	std::vector<int> data;
+	const void* buffers[2];
 };
 
 
 // Auxilliary
-inline IntegerVector prevres_intvec(DataFrame, const char*, const char*, const char*);
+inline IntegerVector prevres_intvec(DataFrame, const char*, const char*, const char*, const char*, const char*);
+inline void as_result(IntegerVector&, const RObject&);
+void progress_report(const char*, long, long);
+void* arrow_address(SEXP);
+template<class T>
+T* arrow_struct(const List&, int, const char*);
+void arrow_check_empty(SEXP, const char*);
+void arrow_export(std::vector<int>, const char*, const char*, SEXP);
+List markov_list(const Markovstats&, const CharacterVector&);
+DataFrame rolling_df(DataFrame, const char*, const char*, const char*, const char*, int, const char*, int, const char*, const char*);
 
 
 // Exported
-DataFrame add_transitions(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* transition, int cap, int modulator); 
-IntegerVector get_transitions(DataFrame object, const char* subject, const char* timepoint, const char* result, int cap, int modulator); 
-DataFrame add_prev_date(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* prev_date);
-DateVector get_prev_date(DataFrame object, const char* subject, const char* timepoint, const char* result);
-DataFrame add_prev_result(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* prev_result);
-IntegerVector get_prev_result(DataFrame object, const char* subject, const char* timepoint, const char* result);
+DataFrame add_transitions(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* transition, int cap, int modulator, bool progress, const char* sequence, const char* duplicates); 
+IntegerVector get_transitions(DataFrame object, const char* subject, const char* timepoint, const char* result, int cap, int modulator, bool progress, const char* sequence, const char* duplicates); 
+DataFrame add_prev_date(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* prev_date, const char* sequence, const char* duplicates);
+DateVector get_prev_date(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* sequence, const char* duplicates);
+DataFrame add_prev_result(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* prev_result, const char* sequence, const char* duplicates);
+IntegerVector get_prev_result(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* sequence, const char* duplicates);
 List uniques(DataFrame object, const char* subject, const char* timepoint, const char* result);
+DataFrame add_rolling(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* rolling, int window, const char* unit, int positive, const char* sequence, const char* duplicates);
+DataFrame get_rolling(DataFrame object, const char* subject, const char* timepoint, const char* result, int window, const char* unit, int positive, const char* sequence, const char* duplicates);
+List get_markov(DataFrame object, const char* subject, const char* timepoint, const char* result, const char* stratum, const char* sequence, const char* duplicates);
+RObject get_bootstrap(DataFrame object, const char* subject, const char* timepoint, const char* result, int cap, int modulate, int nboot, double conf, bool intervals, int seed, int threads, const char* sequence, const char* duplicates);
+void arrow_transitions(List subject, List timepoint, List result, Nullable<List> prev_date, Nullable<List> prev_result, Nullable<List> transition, int cap, int modulate);
+DataFrame get_ngrams(DataFrame object, const char* subject, const char* timepoint, const char* result, int k, int min_support, int threads, const char* sequence, const char* duplicates);
+DataFrame get_first_transition(DataFrame object, const char* subject, const char* timepoint, const char* result, int cap, int modulate, const char* direction, int magnitude, const char* sequence, const char* duplicates);
+void transition_cache(bool enable, double max_size);
+List transition_cache_info();
+void transition_cache_clear();
 
 #endif  // TRANSITION_H
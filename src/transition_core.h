@@ -0,0 +1,833 @@
+/// __________________________________________________
+/// transition_core.h
+/// __________________________________________________
+
+#ifndef TRANSITION_CORE_H
+#define TRANSITION_CORE_H
+
+/// __________________________________________________
+/// Header-only core of the transition algorithms, free of Rcpp and R, for columns of any type
+/// indexable by row, e.g. std::vector, Rcpp vectors, or views of Arrow or memory-mapped arrays.
+/// Subjects and results are read as int, and time points as double, in days.
+///
+/// Missing values are represented by TRANSITION_NA_INTEGER and TRANSITION_NA_REAL, which may be
+/// defined before inclusion; the defaults have the values of R's NA_INTEGER and a quiet NaN.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef TRANSITION_NA_INTEGER
+#define TRANSITION_NA_INTEGER (std::numeric_limits<int>::min())
+#endif
+
+#ifndef TRANSITION_NA_REAL
+#define TRANSITION_NA_REAL (std::numeric_limits<double>::quiet_NaN())
+#endif
+
+
+/// __________________________________________________
+/// Utility
+
+// Find unique values in vector
+template<class T>
+std::vector<T> get_unique(const std::vector<T> vec)
+{
+//	cout << "@get_unique<T>(const vector<T>) vec " << Demangler(typeid(vec)) << endl;
+	std::vector<T> out { vec };
+	std::sort(out.begin(), out.end());
+	auto last { std::unique(out.begin(), out.end()) };
+	out.erase(last, out.end());
+	return out;
+}
+
+
+// Adjust the difference,symmetrically
+inline int adjust(int diff, int cap, int modulate)
+{
+//	cout << "@adjust(int) diff " << diff << endl;
+	bool neg = std::signbit(diff);
+	diff = abs(diff);
+	if (modulate > 1)
+		diff = (diff + modulate - 1) / modulate;
+	if (bool(cap))
+		diff = (diff < cap) ? diff : cap;
+	return neg ? diff *= -1 : diff;
+}
+
+
+// Sample quantile by linear interpolation, as type 7 of R quantile(), partially sorting vec
+inline double quantile(std::vector<double>& vec, double prob)
+{
+//	cout << "@quantile(vector<double>&, double) prob " << prob << endl;
+	if (vec.empty())
+		return TRANSITION_NA_REAL;
+	double h { (vec.size() - 1) * prob };
+	size_t lo = std::floor(h);
+	std::nth_element(vec.begin(), vec.begin() + lo, vec.end());
+	double lower { vec[lo] };
+	if (lo + 1 == vec.size())
+		return lower;
+	double upper { *std::min_element(vec.begin() + lo + 1, vec.end()) };
+	return lower + (h - lo) * (upper - lower);
+}
+
+
+/// __________________________________________________
+/// Chunked execution
+
+// Callback between chunks of work with the name of the step and the numbers of rows done and in
+// total, e.g. to report progress or check for interrupts. It may throw to abandon the computation,
+// all working storage being held in containers and so released on unwinding.
+using Progress = std::function<void(const char*, long, long)>;
+
+// Minimum number of rows in each chunk of whole subjects between calls of a Progress callback
+constexpr int chunk_rows { 1 << 16 };
+
+
+/// __________________________________________________
+/// Ordering of tests
+
+// Placeholder for an absent column, reading zero for every row
+struct Nocolumn {
+	double operator[](long) const { return 0; }
+};
+
+// Treatment of duplicate tests, those of a subject with the same time point and sequence: raise an
+// error, or represent them as the previous test by the first or last in row order, or by that with
+// the highest result
+enum class Duplicates { error, first, last, aggregate };
+
+
+/// __________________________________________________
+/// Struct Grouping
+
+// Rows ordered by subject then date. When all dates are whole numbers of days and no subject spans
+// more than 65534 days, dates are also kept in grouped order as 16-bit offsets from each subject's
+// first date, so that traversals sweep contiguous memory; otherwise, days is empty and dates are
+// read from the column.
+struct Grouping {
+	std::vector<int> index;
+	std::vector<int> bounds;
+	std::vector<uint16_t> days;
+	static constexpr uint16_t naday { std::numeric_limits<uint16_t>::max() };
+	template<class I, class D, class S = Nocolumn>
+	Grouping(const I&, const D&, int, const Progress& = nullptr, const S& = S());
+	int nsub() const { return bounds.size() - 1; }
+	bool compact() const { return days.size() == index.size(); }
+
+	// Whether the date at position p in grouped order is missing
+	template<class D>
+	bool na(const D& date, int p) const { return compact() ? naday == days[p] : std::isnan(double(date[index[p]])); }
+
+	// Days from the date at position q to that at p, both of the same subject, or NaN if either is missing
+	template<class D>
+	double diff(const D& date, int p, int q) const
+	{
+		if (!compact())
+			return date[index[p]] - date[index[q]];
+		return (naday == days[p] || naday == days[q]) ? std::numeric_limits<double>::quiet_NaN() : double(days[p]) - days[q];
+	}
+
+	size_t bytes() const { return (index.capacity() + bounds.capacity()) * sizeof(int) + days.capacity() * sizeof(uint16_t); }
+};
+
+// Row indices stably ordered by subject, date then any sequence, missing dates and sequences last,
+// with offsets of each subject's first row, and dates as offsets if they fit
+template<class I, class D, class S>
+Grouping::Grouping(const I& id, const D& date, int nrows, const Progress& progress, const S& seq) : index(nrows)
+{
+//	cout << "@Grouping::Grouping<I, D, S>(const I&, const D&, int, const Progress&, const S&) nrows " << nrows << endl;
+	if (progress)
+		progress("ordering", 0, nrows);
+	std::iota(index.begin(), index.end(), 0);
+	auto before = [](double a, double b) { return a < b || (!std::isnan(a) && std::isnan(b)); };
+	std::stable_sort(index.begin(), index.end(), [&id, &date, &seq, &before](int a, int b) {
+		if (id[a] != id[b])
+			return id[a] < id[b];
+		if (before(date[a], date[b]) || before(date[b], date[a]))
+			return before(date[a], date[b]);
+		return before(seq[a], seq[b]);
+	});
+	for (int p { 0 }; p < nrows; ++p)
+		if (!p || id[index[p]] != id[index[p - 1]])
+			bounds.push_back(p);
+	bounds.push_back(nrows);
+	if (progress)
+		progress("ordering", nrows, nrows);
+
+	days.resize(nrows);
+	for (int s { 0 }; s < nsub(); ++s) {
+		double origin = date[index[bounds[s]]];
+		for (int p { bounds[s] }; p < bounds[s + 1]; ++p) {
+			double d = date[index[p]];
+			if (std::isnan(d))
+				days[p] = naday;
+			else if (d == std::floor(d) && d - origin < naday)
+				days[p] = d - origin;
+			else {
+				days.clear();
+				days.shrink_to_fit();
+				return;
+			}
+		}
+	}
+}
+
+
+/// __________________________________________________
+/// Struct Packedresults
+
+// Results in grouped order, packed into 8-bit codes when they span no more than 255 values,
+// otherwise as int
+struct Packedresults {
+	std::vector<uint8_t> codes;
+	std::vector<int> values;
+	int base = 0;
+	static constexpr uint8_t nacode { 255 };
+	template<class R>
+	Packedresults(const Grouping&, const R&);
+	int operator[](int p) const
+	{
+		if (values.empty())
+			return nacode == codes[p] ? TRANSITION_NA_INTEGER : codes[p] + base;
+		return values[p];
+	}
+	size_t bytes() const { return codes.capacity() * sizeof(uint8_t) + values.capacity() * sizeof(int); }
+};
+
+// Gather results into grouped order, choosing the narrowest representation
+template<class R>
+Packedresults::Packedresults(const Grouping& grp, const R& result)
+{
+//	cout << "@Packedresults::Packedresults<R>(const Grouping&, const R&) nrows " << grp.index.size() << endl;
+	int nrows = grp.index.size();
+	long lo { std::numeric_limits<int>::max() }, hi { std::numeric_limits<int>::min() };
+	for (int row { 0 }; row < nrows; ++row) {
+		int curr = result[row];
+		if (TRANSITION_NA_INTEGER != curr) {
+			lo = std::min<long>(lo, curr);
+			hi = std::max<long>(hi, curr);
+		}
+	}
+	if (hi - lo < nacode) {
+		base = lo;
+		codes.resize(nrows);
+		for (int p { 0 }; p < nrows; ++p) {
+			int curr = result[grp.index[p]];
+			codes[p] = TRANSITION_NA_INTEGER == curr ? nacode : curr - base;
+		}
+	} else {
+		values.resize(nrows);
+		for (int p { 0 }; p < nrows; ++p)
+			values[p] = result[grp.index[p]];
+	}
+}
+
+
+/// __________________________________________________
+/// Grouped traversal
+
+// Column of results read in grouped order
+template<class R>
+struct Groupedview {
+	const Grouping& grp;
+	const R& result;
+	int operator[](int p) const { return result[grp.index[p]]; }
+};
+
+// Call fn(first, last, rep) for each run of positions from first to last - 1 of tests of subject s
+// tied on date and sequence, up to any missing date, where rep is the position of the test
+// representing the run according to dups, given results in grouped order
+template<class D, class S, class R, class F>
+void tied_runs(const Grouping& grp, int s, const D& date, const S& seq, const R& res, Duplicates dups, F fn)
+{
+	auto tied = [&grp, &date, &seq](int p, int q) {
+		double a = seq[grp.index[p]], b = seq[grp.index[q]];
+		return grp.diff(date, p, q) == 0 && (a == b || (std::isnan(a) && std::isnan(b)));
+	};
+	for (int first { grp.bounds[s] }, last; first < grp.bounds[s + 1] && !grp.na(date, first); first = last) {
+		for (last = first + 1; last < grp.bounds[s + 1] && tied(last, first); ++last)
+			;
+		if (Duplicates::error == dups && last - first > 1)
+			throw std::invalid_argument("duplicate tests for subject at the same time point");
+		int rep { Duplicates::last == dups ? last - 1 : first };
+		if (Duplicates::aggregate == dups)
+			for (int p { first + 1 }; p < last; ++p)
+				if (TRANSITION_NA_INTEGER != int(res[p]) && (TRANSITION_NA_INTEGER == int(res[rep]) || res[p] > res[rep]))
+					rep = p;
+		fn(first, last, rep);
+	}
+}
+
+// Row of the most recent previous test for each row, or -1 if none, given a grouping by the same
+// sequence, with duplicate tests represented according to dups
+template<class D, class S = Nocolumn, class R = Nocolumn>
+std::vector<int> prev_rows(const Grouping& grp, const D& date, const Progress& progress = nullptr, const S& seq = S(), const R& result = R(), Duplicates dups = Duplicates::first)
+{
+//	cout << "@prev_rows<D, S, R>(const Grouping&, const D&, const Progress&, const S&, const R&, Duplicates) nsub " << grp.nsub() << endl;
+	long nrows = grp.index.size();
+	std::vector<int> previous(nrows, -1);
+	for (int s { 0 }, done { 0 }; s < grp.nsub(); ++s) {
+		if (progress && grp.bounds[s] - done >= chunk_rows)
+			progress("previous", done = grp.bounds[s], nrows);
+		int prevrep { -1 };
+		tied_runs(grp, s, date, seq, Groupedview<R> { grp, result }, dups, [&grp, &previous, &prevrep](int first, int last, int rep) {
+			if (prevrep >= 0)
+				for (int p { first }; p < last; ++p)
+					previous[grp.index[p]] = prevrep;
+			prevrep = grp.index[rep];
+		});
+	}
+	if (progress)
+		progress("previous", nrows, nrows);
+	return previous;
+}
+
+// Row of the most recent previous test for each row, or -1 if none
+template<class I, class D>
+std::vector<int> prev_rows(const I& id, const D& date, int nrows)
+{
+//	cout << "@prev_rows<I, D>(const I&, const D&, int) nrows " << nrows << endl;
+	return prev_rows(Grouping(id, date, nrows), date);
+}
+
+
+// Adjusted differences between the result of each row and of its previous row, in chunks of rows
+template<class R>
+std::vector<int> transition_rows(const std::vector<int>& prevrow, const R& result, int cap, int modulate, const Progress& progress = nullptr)
+{
+//	cout << "@transition_rows<R>(const vector<int>&, const R&, int, int, const Progress&) cap = " << cap << "; modulate = " << modulate << endl;
+	if (cap < 0)
+		throw std::invalid_argument("\"cap\" less than zero");
+	if (modulate < 0)
+		throw std::invalid_argument("\"modulate\" less than zero");
+	long nrows = prevrow.size();
+	std::vector<int> transitions(nrows);
+	for (long first { 0 }; first < nrows; first += chunk_rows) {
+		if (progress)
+			progress("transitions", first, nrows);
+		for (long row { first }; row < std::min(first + chunk_rows, nrows); ++row) {
+			int prev { prevrow[row] < 0 ? TRANSITION_NA_INTEGER : int(result[prevrow[row]]) }, curr = result[row];
+			transitions[row] = (TRANSITION_NA_INTEGER == prev || TRANSITION_NA_INTEGER == curr) ? TRANSITION_NA_INTEGER : adjust(curr - prev, cap, modulate);
+		}
+	}
+	if (progress)
+		progress("transitions", nrows, nrows);
+	return transitions;
+}
+
+
+/// __________________________________________________
+/// Struct Grouped
+
+// Grouping with results in grouped order and the previous row of each row
+struct Grouped {
+	Grouping grp;
+	Packedresults res;
+	std::vector<int> prevrow;
+	template<class I, class D, class S = Nocolumn, class R = Nocolumn>
+	Grouped(const I& id, const D& date, int nrows, const Progress& progress = nullptr, const S& seq = S(), const R& result = R(), Duplicates dups = Duplicates::first) :
+		grp(id, date, nrows, progress, seq), res(grp, result), prevrow(prev_rows(grp, date, progress, seq, result, dups)) {}
+	size_t bytes() const { return sizeof(Grouped) + grp.bytes() + res.bytes() + prevrow.capacity() * sizeof(int); }
+};
+
+
+/// __________________________________________________
+/// Struct Fingerprint
+
+// Identity of subject, time point, result and any sequence columns, by address, length and a hash
+// of a sample of rows
+struct Fingerprint {
+	const void* id = nullptr;
+	const void* date = nullptr;
+	const void* seq = nullptr;
+	const void* result = nullptr;
+	Duplicates dups = Duplicates::first;
+	int nrows = 0;
+	uint64_t hash = 0;
+
+	bool operator==(const Fingerprint& fp) const
+	{
+		return id == fp.id && date == fp.date && seq == fp.seq && result == fp.result && dups == fp.dups && nrows == fp.nrows && hash == fp.hash;
+	}
+
+	// Mix up to 64 evenly spaced rows and the last row of a column into the hash
+	template<class C>
+	void sample(const C& col)
+	{
+		auto mix = [this, &col](int row) {
+			double d = col[row];
+			uint64_t bits;
+			std::memcpy(&bits, &d, sizeof bits);
+			hash ^= bits + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+		};
+		for (int row { 0 }, step { std::max(1, nrows / 64) }; row < nrows; row += step)
+			mix(row);
+		if (nrows)
+			mix(nrows - 1);
+	}
+};
+
+// Fingerprint of subject and time point columns
+template<class I, class D>
+Fingerprint fingerprint(const void* idaddr, const I& id, const void* dateaddr, const D& date, int nrows)
+{
+//	cout << "@fingerprint<I, D>(const void*, const I&, const void*, const D&, int) nrows " << nrows << endl;
+	Fingerprint fp;
+	fp.id = idaddr;
+	fp.date = dateaddr;
+	fp.nrows = nrows;
+	fp.sample(id);
+	fp.sample(date);
+	return fp;
+}
+
+
+/// __________________________________________________
+/// Class Groupcache
+
+// Least recently used cache of groupings and previous rows, limited by memory
+class Groupcache {
+	struct Entry {
+		Fingerprint key;
+		std::shared_ptr<const Grouped> grouped;
+		std::shared_ptr<const void> keep;
+	};
+	std::list<Entry> entries;
+	size_t maxbytes;
+	size_t bytes = 0;
+	long hits = 0;
+	long misses = 0;
+	bool on = false;
+	mutable std::mutex mtx;
+
+	void evict(size_t limit)
+	{
+		while (bytes > limit && !entries.empty()) {
+			bytes -= entries.back().grouped->bytes();
+			entries.pop_back();
+		}
+	}
+
+public:
+	explicit Groupcache(size_t _maxbytes) : maxbytes(_maxbytes) {}
+
+	struct Info {
+		bool enabled;
+		int entries;
+		size_t bytes, maxbytes;
+		long hits, misses;
+	};
+
+	bool enabled() const
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		return on;
+	}
+
+	void enable(bool enable, size_t _maxbytes)
+	{
+//		cout << "@Groupcache::enable(bool, size_t) enable " << enable << "; maxbytes " << _maxbytes << endl;
+		std::lock_guard<std::mutex> lock(mtx);
+		on = enable;
+		maxbytes = _maxbytes;
+		evict(on ? maxbytes : 0);
+	}
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		evict(0);
+		hits = misses = 0;
+	}
+
+	Info info() const
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		return Info { on, int(entries.size()), bytes, maxbytes, hits, misses };
+	}
+
+	// Cached grouping for the fingerprint, or one newly built by build() and cached if small enough,
+	// along with keep, which should hold the fingerprinted columns so that their addresses cannot be
+	// reused while cached
+	template<class F>
+	std::shared_ptr<const Grouped> get(const Fingerprint& key, F build, std::shared_ptr<const void> keep = nullptr)
+	{
+//		cout << "@Groupcache::get<F>(const Fingerprint&, F, shared_ptr<const void>) nrows " << key.nrows << endl;
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			auto it { std::find_if(entries.begin(), entries.end(), [&key](const Entry& e) { return e.key == key; }) };
+			if (it != entries.end()) {
+				++hits;
+				entries.splice(entries.begin(), entries, it);
+				return it->grouped;
+			}
+			++misses;
+		}
+		std::shared_ptr<const Grouped> grouped { build() };
+		std::lock_guard<std::mutex> lock(mtx);
+		if (on && grouped->bytes() <= maxbytes) {
+			bytes += grouped->bytes();
+			entries.push_front(Entry { key, grouped, std::move(keep) });
+			evict(maxbytes);
+		}
+		return grouped;
+	}
+};
+
+
+/// __________________________________________________
+/// Struct Rollstats
+
+struct Rollstats {
+	std::vector<int> max, min, n, pos;
+	std::vector<double> mean;
+	explicit Rollstats(int nrows) : max(nrows), min(nrows), n(nrows), pos(nrows), mean(nrows) {}
+};
+
+// Rolling window statistics of past results within subjects, by number of tests or days, given a
+// grouping by the same sequence and its results; each run of duplicate tests enters windows as the
+// test representing it according to dups, whose statistics all of them share, while tests with a
+// missing date, ordered last, are left out of every window and their statistics are NA
+template<class D, class S = Nocolumn>
+Rollstats rolling_stats(const Grouping& grp, const D& date, const Packedresults& res, int window, bool bydays, int positive, const S& seq = S(), Duplicates dups = Duplicates::first)
+{
+//	cout << "@rolling_stats<D, S>(const Grouping&, const D&, const Packedresults&, int, bool, int, const S&, Duplicates) window = " << window << "; bydays = " << bydays << endl;
+	if (window < 1)
+		throw std::invalid_argument("\"window\" less than one");
+	Rollstats out(grp.index.size());
+	std::vector<int> reps, firsts;
+	std::deque<int> maxq, minq;
+	for (int s { 0 }; s < grp.nsub(); ++s) {
+		reps.clear();
+		firsts.clear();
+		maxq.clear();
+		minq.clear();
+		int end { grp.bounds[s] };
+		tied_runs(grp, s, date, seq, res, dups, [&reps, &firsts, &end](int first, int last, int rep) {
+			reps.push_back(rep);
+			firsts.push_back(first);
+			end = last;
+		});
+		firsts.push_back(end);
+		int count { 0 }, poscount { 0 };
+		long sum { 0 };
+		for (int l { 0 }, i { 0 }; i < int(reps.size()); ++i) {
+			int curr { res[reps[i]] };
+			if (TRANSITION_NA_INTEGER != curr) {
+				while (!maxq.empty() && res[reps[maxq.back()]] <= curr)
+					maxq.pop_back();
+				maxq.push_back(i);
+				while (!minq.empty() && res[reps[minq.back()]] >= curr)
+					minq.pop_back();
+				minq.push_back(i);
+				++count;
+				sum += curr;
+				poscount += curr >= positive;
+			}
+			for (; l < i && (bydays ? !(grp.diff(date, reps[i], reps[l]) < window) : i - l >= window); ++l) {
+				int prev { res[reps[l]] };
+				if (TRANSITION_NA_INTEGER == prev)
+					continue;
+				--count;
+				sum -= prev;
+				poscount -= prev >= positive;
+			}
+			while (!maxq.empty() && maxq.front() < l)
+				maxq.pop_front();
+			while (!minq.empty() && minq.front() < l)
+				minq.pop_front();
+			for (int p { firsts[i] }; p < firsts[i + 1]; ++p) {
+				int row { grp.index[p] };
+				out.max[row] = maxq.empty() ? TRANSITION_NA_INTEGER : res[reps[maxq.front()]];
+				out.min[row] = minq.empty() ? TRANSITION_NA_INTEGER : res[reps[minq.front()]];
+				out.n[row] = count;
+				out.pos[row] = poscount;
+				out.mean[row] = count ? double(sum) / count : TRANSITION_NA_REAL;
+			}
+		}
+		for (int p { end }; p < grp.bounds[s + 1]; ++p) {
+			int row { grp.index[p] };
+			out.max[row] = out.min[row] = out.n[row] = out.pos[row] = TRANSITION_NA_INTEGER;
+			out.mean[row] = TRANSITION_NA_REAL;
+		}
+	}
+	return out;
+}
+
+// Rolling window statistics of past results within subjects, by number of tests or days
+template<class I, class D, class R>
+Rollstats rolling_stats(const I& id, const D& date, const R& result, int nrows, int window, bool bydays, int positive)
+{
+//	cout << "@rolling_stats<I, D, R>(const I&, const D&, const R&, int, int, bool, int) window = " << window << "; bydays = " << bydays << endl;
+	Grouping grp(id, date, nrows);
+	return rolling_stats(grp, date, Packedresults(grp, result), window, bydays, positive);
+}
+
+
+/// __________________________________________________
+/// Struct Markovstats
+
+struct Markovstats {
+	int nstates;
+	std::vector<int> counts;
+	std::vector<double> atrisk;
+	explicit Markovstats(int n) : nstates(n), counts(n * n), atrisk(n) {}
+};
+
+// Transition counts and time at risk between result levels, by stratum of earlier row, in one pass
+template<class D, class R>
+std::vector<Markovstats> markov_stats(const std::vector<int>& prevrow, const D& date, const R& result, int nstates, int base, const std::vector<int>& stratum, int nstrata)
+{
+//	cout << "@markov_stats<D, R>(const vector<int>&, const D&, const R&, int, int, const vector<int>&, int) nstates = " << nstates << "; nstrata = " << nstrata << endl;
+	std::vector<Markovstats> out(nstrata, Markovstats(nstates));
+	for (size_t row { 0 }; row < prevrow.size(); ++row) {
+		int prev { prevrow[row] };
+		if (prev < 0 || TRANSITION_NA_INTEGER == result[prev] || TRANSITION_NA_INTEGER == result[row])
+			continue;
+		int s { stratum.empty() ? 0 : stratum[prev] };
+		if (s < 0)
+			continue;
+		int from = result[prev] - base, to = result[row] - base;
+		if (from < 0 || from >= nstates || to < 0 || to >= nstates)
+			throw std::invalid_argument("result level out of range");
+		++out[s].counts[from * nstates + to];
+		out[s].atrisk[from] += date[row] - date[prev];
+	}
+	return out;
+}
+
+
+/// __________________________________________________
+/// Struct Bootsummary
+
+struct Bootsummary {
+	std::vector<int> values;
+	std::vector<int> counts;
+	int nsub = 0;
+};
+
+// Counts of each transition value for each subject
+template<class I>
+Bootsummary subject_counts(const I& id, const std::vector<int>& transitions)
+{
+//	cout << "@subject_counts<I>(const I&, const vector<int>&) nrows " << transitions.size() << endl;
+	int nrows = transitions.size();
+	std::vector<int> subjects(nrows);
+	for (int row { 0 }; row < nrows; ++row)
+		subjects[row] = id[row];
+	subjects = get_unique(subjects);
+	Bootsummary bs;
+	bs.nsub = subjects.size();
+	bs.values = get_unique(transitions);
+	if (!bs.values.empty() && TRANSITION_NA_INTEGER == bs.values.front())
+		bs.values.erase(bs.values.begin());
+	int nvals = bs.values.size();
+	bs.counts.assign(bs.nsub * nvals, 0);
+	for (int row { 0 }; row < nrows; ++row) {
+		if (TRANSITION_NA_INTEGER == transitions[row])
+			continue;
+		int s = std::lower_bound(subjects.begin(), subjects.end(), int(id[row])) - subjects.begin();
+		int v = std::lower_bound(bs.values.begin(), bs.values.end(), transitions[row]) - bs.values.begin();
+		++bs.counts[s * nvals + v];
+	}
+	return bs;
+}
+
+// Replicate transition counts resampling subjects, seeding a generator for each replicate
+inline std::vector<int> bootstrap(const Bootsummary& bs, int nboot, unsigned seed, int threads)
+{
+//	cout << "@bootstrap(const Bootsummary&, int, unsigned, int) nboot " << nboot << "; threads " << threads << endl;
+	int nvals = bs.values.size();
+	std::vector<int> reps(nboot * nvals);
+	if (!bs.nsub)
+		return reps;
+	auto worker = [&bs, &reps, nvals, seed](int first, int last) {
+		for (int b { first }; b < last; ++b) {
+			std::seed_seq seq { seed, unsigned(b) };
+			std::mt19937 gen(seq);
+			std::uniform_int_distribution<int> pick(0, bs.nsub - 1);
+			int* rep { reps.data() + b * nvals };
+			for (int i { 0 }; i < bs.nsub; ++i) {
+				const int* sub { bs.counts.data() + pick(gen) * nvals };
+				for (int v { 0 }; v < nvals; ++v)
+					rep[v] += sub[v];
+			}
+		}
+	};
+	threads = std::max(1, std::min(threads, nboot));
+	std::vector<std::thread> pool;
+	for (int t { 1 }; t < threads; ++t)
+		pool.emplace_back(worker, long(nboot) * t / threads, long(nboot) * (t + 1) / threads);
+	worker(0, nboot / threads);
+	for (auto& th : pool)
+		th.join();
+	return reps;
+}
+
+
+/// __________________________________________________
+/// Struct Firststats
+
+struct Firststats {
+	std::vector<int> subject, status, transition;
+	std::vector<double> start, time;
+	explicit Firststats(int nsub) : subject(nsub), status(nsub), transition(nsub), start(nsub), time(nsub) {}
+};
+
+// Time from first test to first transition in a given direction (1 up, -1 down, 0 either) of at
+// least a given magnitude after adjustment, or to last test if censored, for each subject, given
+// a grouping and previous rows
+template<class I, class D, class R>
+Firststats first_transitions(const Grouping& grp, const std::vector<int>& prevrow, const I& id, const D& date, const R& result, int cap, int modulate, int direction, int magnitude)
+{
+//	cout << "@first_transitions<I, D, R>(const Grouping&, const vector<int>&, const I&, const D&, const R&, int, int, int, int) direction = " << direction << "; magnitude = " << magnitude << endl;
+	if (magnitude < 1)
+		throw std::invalid_argument("\"magnitude\" less than one");
+	auto transitions { transition_rows(prevrow, result, cap, modulate) };
+	Firststats out(grp.nsub());
+	for (int s { 0 }; s < grp.nsub(); ++s) {
+		int first { grp.bounds[s] }, last { first };
+		out.subject[s] = id[grp.index[first]];
+		out.status[s] = 0;
+		out.transition[s] = TRANSITION_NA_INTEGER;
+		for (int p { first }; p < grp.bounds[s + 1] && !grp.na(date, p); ++p) {
+			last = p;
+			int trans { transitions[grp.index[p]] };
+			if (TRANSITION_NA_INTEGER != trans && std::abs(trans) >= magnitude && (!direction || (trans > 0) == (direction > 0))) {
+				out.status[s] = 1;
+				out.transition[s] = trans;
+				break;
+			}
+		}
+		double start = date[grp.index[first]];
+		out.start[s] = std::isnan(start) ? TRANSITION_NA_REAL : start;
+		out.time[s] = std::isnan(start) ? TRANSITION_NA_REAL : grp.diff(date, last, first);
+	}
+	return out;
+}
+
+// Time from first test to first transition for each subject
+template<class I, class D, class R>
+Firststats first_transitions(const I& id, const D& date, const R& result, int nrows, int cap, int modulate, int direction, int magnitude)
+{
+//	cout << "@first_transitions<I, D, R>(const I&, const D&, const R&, int, int, int, int, int) direction = " << direction << "; magnitude = " << magnitude << endl;
+	Grouping grp(id, date, nrows);
+	return first_transitions(grp, prev_rows(grp, date), id, date, result, cap, modulate, direction, magnitude);
+}
+
+
+/// __________________________________________________
+/// Sequence mining
+
+// Run fn(t) for t in 0 to threads - 1 each on its own thread, rethrowing any exception on return
+template<class F>
+void run_threads(int threads, F fn)
+{
+//	cout << "@run_threads<F>(int, F) threads " << threads << endl;
+	std::vector<std::thread> pool;
+	std::vector<std::exception_ptr> errors(threads);
+	for (int t { 0 }; t < threads; ++t)
+		pool.emplace_back([&fn, &errors, t]() {
+			try {
+				fn(t);
+			} catch (...) {
+				errors[t] = std::current_exception();
+			}
+		});
+	for (auto& th : pool)
+		th.join();
+	for (auto& err : errors)
+		if (err)
+			std::rethrow_exception(err);
+}
+
+// Counts of each sequence of k consecutive results within subjects, up to any missing time point,
+// keyed by packing levels as digits in base nlevels, for sequences occurring at least minsupport
+// times, given a grouping by the same sequence and its results, with each run of duplicate tests
+// taken as the test representing it according to dups. Each thread counts a share of subjects into
+// tables partitioned by key, then merges one partition across all threads.
+template<class D, class S = Nocolumn>
+std::vector<std::pair<uint64_t, int>> ngram_counts(const Grouping& grp, const D& date, const Packedresults& res, int k, int nlevels, int base, int minsupport, int threads, const S& seq = S(), Duplicates dups = Duplicates::first)
+{
+//	cout << "@ngram_counts<D, S>(const Grouping&, const D&, const Packedresults&, int, int, int, int, int, const S&, Duplicates) k = " << k << "; nlevels = " << nlevels << endl;
+	if (k < 1)
+		throw std::invalid_argument("\"k\" less than one");
+	if (nlevels < 1)
+		throw std::invalid_argument("fewer than one result level");
+	uint64_t span { 1 };
+	for (int i { 0 }; i < k; ++i) {
+		if (span > std::numeric_limits<uint64_t>::max() / nlevels)
+			throw std::invalid_argument("too many result levels for sequences of length \"k\"");
+		span *= nlevels;
+	}
+	uint64_t lead { span / nlevels };
+	threads = std::max(1, std::min(threads, grp.nsub()));
+	std::vector<std::vector<std::unordered_map<uint64_t, int>>> tables(threads, std::vector<std::unordered_map<uint64_t, int>>(threads));
+	run_threads(threads, [&](int t) {
+		auto& parts { tables[t] };
+		for (int s = long(grp.nsub()) * t / threads; s < long(grp.nsub()) * (t + 1) / threads; ++s) {
+			uint64_t key { 0 };
+			int len { 0 };
+			tied_runs(grp, s, date, seq, res, dups, [&](int, int, int rep) {
+				int curr { res[rep] };
+				if (TRANSITION_NA_INTEGER == curr) {
+					len = 0;
+					return;
+				}
+				if (curr - base < 0 || curr - base >= nlevels)
+					throw std::invalid_argument("result level out of range");
+				key = key % lead * nlevels + (curr - base);
+				if (++len >= k)
+					++parts[key % threads][key];
+			});
+		}
+	});
+
+	std::vector<std::vector<std::pair<uint64_t, int>>> merged(threads);
+	run_threads(threads, [&](int part) {
+		auto& table { tables[0][part] };
+		for (int t { 1 }; t < threads; ++t) {
+			for (const auto& kv : tables[t][part])
+				table[kv.first] += kv.second;
+			std::unordered_map<uint64_t, int>().swap(tables[t][part]);
+		}
+		for (const auto& kv : table)
+			if (kv.second >= minsupport)
+				merged[part].push_back(kv);
+	});
+	std::vector<std::pair<uint64_t, int>> out;
+	for (auto& part : merged)
+		out.insert(out.end(), part.begin(), part.end());
+	std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) { return a.second != b.second ? a.second > b.second : a.first < b.first; });
+	return out;
+}
+
+// Counts of each sequence of k consecutive results within subjects
+template<class I, class D, class R>
+std::vector<std::pair<uint64_t, int>> ngram_counts(const I& id, const D& date, const R& result, int nrows, int k, int nlevels, int base, int minsupport, int threads)
+{
+//	cout << "@ngram_counts<I, D, R>(const I&, const D&, const R&, int, int, int, int, int, int) k = " << k << "; nlevels = " << nlevels << endl;
+	Grouping grp(id, date, nrows);
+	return ngram_counts(grp, date, Packedresults(grp, result), k, nlevels, base, minsupport, threads);
+}
+
+#endif  // TRANSITION_CORE_H